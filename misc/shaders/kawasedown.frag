@@ -0,0 +1,24 @@
+#version 440
+
+layout(location = 0) in vec2 qt_TexCoord0;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    vec2 halfPixel;
+};
+
+layout(binding = 1) uniform sampler2D source;
+
+// Dual Kawase downsample, the output is half the size of the source
+void main()
+{
+    vec4 sum = texture(source, qt_TexCoord0) * 4.0;
+    sum += texture(source, qt_TexCoord0 - halfPixel);
+    sum += texture(source, qt_TexCoord0 + halfPixel);
+    sum += texture(source, qt_TexCoord0 + vec2(halfPixel.x, -halfPixel.y));
+    sum += texture(source, qt_TexCoord0 - vec2(halfPixel.x, -halfPixel.y));
+    fragColor = sum / 8.0 * qt_Opacity;
+}
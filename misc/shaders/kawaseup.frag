@@ -0,0 +1,32 @@
+#version 440
+
+layout(location = 0) in vec2 qt_TexCoord0;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    vec2 halfPixel;
+    float saturation;
+};
+
+layout(binding = 1) uniform sampler2D source;
+
+// Dual Kawase upsample, the output is twice the size of the source
+void main()
+{
+    vec4 sum = texture(source, qt_TexCoord0 + vec2(-halfPixel.x * 2.0, 0.0));
+    sum += texture(source, qt_TexCoord0 + vec2(-halfPixel.x, halfPixel.y)) * 2.0;
+    sum += texture(source, qt_TexCoord0 + vec2(0.0, halfPixel.y * 2.0));
+    sum += texture(source, qt_TexCoord0 + vec2(halfPixel.x, halfPixel.y)) * 2.0;
+    sum += texture(source, qt_TexCoord0 + vec2(halfPixel.x * 2.0, 0.0));
+    sum += texture(source, qt_TexCoord0 + vec2(halfPixel.x, -halfPixel.y)) * 2.0;
+    sum += texture(source, qt_TexCoord0 + vec2(0.0, -halfPixel.y * 2.0));
+    sum += texture(source, qt_TexCoord0 + vec2(-halfPixel.x, -halfPixel.y)) * 2.0;
+
+    vec4 color = sum / 12.0;
+    float gray = dot(color.rgb, vec3(0.2126, 0.7152, 0.0722));
+    color.rgb = mix(vec3(gray), color.rgb, 1.0 + saturation);
+    fragColor = color * qt_Opacity;
+}
@@ -0,0 +1,35 @@
+#version 440
+
+layout(location = 0) in vec2 texCoord;
+layout(location = 1) in vec2 localPos;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float opacity;
+    float antialiasingWidth;
+    vec4 rect;
+    vec4 sourceRect;
+    // top left, top right, bottom right, bottom left
+    vec4 radius;
+} ubuf;
+
+layout(binding = 1) uniform sampler2D qt_Texture;
+
+void main()
+{
+    vec2 halfSize = ubuf.rect.zw * 0.5;
+    vec2 p = localPos - halfSize;
+    float r = p.x < 0.0 ? (p.y < 0.0 ? ubuf.radius.x : ubuf.radius.w)
+                        : (p.y < 0.0 ? ubuf.radius.y : ubuf.radius.z);
+
+    // Signed distance to the rounded rect, negative inside
+    vec2 q = abs(p) - halfSize + r;
+    float dist = min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - r;
+
+    float alpha = ubuf.antialiasingWidth > 0.0
+        ? clamp(0.5 - dist / ubuf.antialiasingWidth, 0.0, 1.0)
+        : step(dist, 0.0);
+    fragColor = texture(qt_Texture, texCoord) * (alpha * ubuf.opacity);
+}
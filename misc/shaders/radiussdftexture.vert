@@ -0,0 +1,25 @@
+#version 440
+
+layout(location = 0) in vec2 vertex;
+
+layout(location = 0) out vec2 texCoord;
+layout(location = 1) out vec2 localPos;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float opacity;
+    float antialiasingWidth;
+    vec4 rect;
+    vec4 sourceRect;
+    vec4 radius;
+} ubuf;
+
+out gl_PerVertex { vec4 gl_Position; };
+
+// The geometry is the corners of rect in item coordinates
+void main()
+{
+    localPos = vertex - ubuf.rect.xy;
+    texCoord = ubuf.sourceRect.xy + localPos / ubuf.rect.zw * ubuf.sourceRect.zw;
+    gl_Position = ubuf.qt_Matrix * vec4(vertex, 0.0, 1.0);
+}
@@ -26,6 +26,8 @@ TreelandConfig::TreelandConfig()
     , m_fontSize(m_dconfig->value("fontSize", 105).toUInt())
     , m_iconThemeName(m_dconfig->value("iconThemeName").toString())
     , m_defaultBackground(m_dconfig->value("defaultBackground").toString())
+    , m_decorationReleaseDelay(m_dconfig->value("decorationReleaseDelay", 0).toUInt())
+    , m_foreignToplevelTitleInterval(m_dconfig->value("foreignToplevelTitleInterval", 0).toUInt())
 {
     connect(m_dconfig.get(), &DConfig::valueChanged, this, &TreelandConfig::onDConfigChanged);
 }
@@ -564,3 +566,44 @@ QString TreelandConfig::defaultBackground()
 
     return m_defaultBackground;
 }
+
+void TreelandConfig::setDecorationReleaseDelay(uint delay)
+{
+    if (m_decorationReleaseDelay == delay) {
+        return;
+    }
+
+    m_decorationReleaseDelay = delay;
+
+    m_dconfig->setValue("decorationReleaseDelay", delay);
+
+    emit decorationReleaseDelayChanged();
+}
+
+uint TreelandConfig::decorationReleaseDelay()
+{
+    m_decorationReleaseDelay = m_dconfig->value("decorationReleaseDelay", 0).toUInt();
+
+    return m_decorationReleaseDelay;
+}
+
+void TreelandConfig::setForeignToplevelTitleInterval(uint interval)
+{
+    if (m_foreignToplevelTitleInterval == interval) {
+        return;
+    }
+
+    m_foreignToplevelTitleInterval = interval;
+
+    m_dconfig->setValue("foreignToplevelTitleInterval", interval);
+
+    emit foreignToplevelTitleIntervalChanged();
+}
+
+uint TreelandConfig::foreignToplevelTitleInterval()
+{
+    m_foreignToplevelTitleInterval =
+        m_dconfig->value("foreignToplevelTitleInterval", 0).toUInt();
+
+    return m_foreignToplevelTitleInterval;
+}
@@ -51,6 +51,8 @@ class TreelandConfig
     Q_PROPERTY(uint32_t fontSize READ fontSize WRITE setFontSize NOTIFY fontSizeChanged FINAL)
     Q_PROPERTY(QString iconThemeName READ iconThemeName WRITE setIconThemeName NOTIFY iconThemeNameChanged FINAL)
     Q_PROPERTY(QString defaultBackground READ defaultBackground NOTIFY defaultBackgroundChanged FINAL)
+    Q_PROPERTY(uint decorationReleaseDelay READ decorationReleaseDelay WRITE setDecorationReleaseDelay NOTIFY decorationReleaseDelayChanged FINAL)
+    Q_PROPERTY(uint foreignToplevelTitleInterval READ foreignToplevelTitleInterval WRITE setForeignToplevelTitleInterval NOTIFY foreignToplevelTitleIntervalChanged FINAL)
 public:
     TreelandConfig();
 
@@ -154,6 +156,12 @@ public:
 
     QString defaultBackground();
 
+    void setDecorationReleaseDelay(uint delay);
+    uint decorationReleaseDelay();
+
+    void setForeignToplevelTitleInterval(uint interval);
+    uint foreignToplevelTitleInterval();
+
 Q_SIGNALS:
     void workspaceThumbMarginChanged();
     void workspaceThumbHeightChanged();
@@ -189,6 +197,8 @@ Q_SIGNALS:
     void fontSizeChanged();
     void iconThemeNameChanged();
     void defaultBackgroundChanged();
+    void decorationReleaseDelayChanged();
+    void foreignToplevelTitleIntervalChanged();
 
 private:
     void onDConfigChanged(const QString &key);
@@ -211,6 +221,8 @@ private:
     qreal m_windowRadius;
     QString m_iconThemeName;
     QString m_defaultBackground;
+    uint m_decorationReleaseDelay;
+    uint m_foreignToplevelTitleInterval;
 
     // Local
     uint m_workspaceThumbHeight = 144;
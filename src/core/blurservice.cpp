@@ -0,0 +1,190 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "core/blurservice.h"
+
+#include "core/rootsurfacecontainer.h"
+#include "seat/helper.h"
+#include "surface/surfacewrapper.h"
+
+#include <QQuickWindow>
+
+// Whether a is painted before b, going by z and then child order below
+// their closest common ancestor
+static bool isStackedBelow(QQuickItem *a, QQuickItem *b)
+{
+    QList<QQuickItem *> pathA;
+    QList<QQuickItem *> pathB;
+    for (auto item = a; item; item = item->parentItem())
+        pathA.prepend(item);
+    for (auto item = b; item; item = item->parentItem())
+        pathB.prepend(item);
+
+    qsizetype depth = 0;
+    while (depth < pathA.size() && depth < pathB.size() && pathA[depth] == pathB[depth])
+        ++depth;
+    if (depth == 0)
+        return false;
+    // An ancestor is painted before its children
+    if (depth == pathA.size() || depth == pathB.size())
+        return depth == pathA.size();
+
+    auto childA = pathA[depth];
+    auto childB = pathB[depth];
+    if (childA->z() != childB->z())
+        return childA->z() < childB->z();
+    const auto siblings = pathA[depth - 1]->childItems();
+    return siblings.indexOf(childA) < siblings.indexOf(childB);
+}
+
+BlurService::BlurService(QObject *parent)
+    : QObject(parent)
+{
+    auto root = Helper::instance()->rootContainer();
+    connect(root, &SurfaceContainer::surfaceAdded, this, &BlurService::onSurfaceAdded);
+    connect(root, &SurfaceContainer::surfaceRemoved, this, &BlurService::onSurfaceRemoved);
+    for (auto surface : root->surfaces())
+        onSurfaceAdded(surface);
+}
+
+void BlurService::addBackdrop(QQuickItem *texture)
+{
+    if (!texture || m_backdrops.contains(texture))
+        return;
+
+    m_backdrops.append(texture);
+    connect(texture, &QObject::destroyed, this, [this, texture] {
+        m_backdrops.removeAll(texture);
+        Q_EMIT backdropsChanged();
+    });
+    Q_EMIT backdropsChanged();
+}
+
+void BlurService::removeBackdrop(QQuickItem *texture)
+{
+    if (!texture || !m_backdrops.removeAll(texture))
+        return;
+
+    texture->disconnect(this);
+    Q_EMIT backdropsChanged();
+}
+
+QQuickItem *BlurService::backdropAt(const QPointF &scenePos) const
+{
+    for (const auto &backdrop : m_backdrops) {
+        if (backdrop && backdrop->mapRectToScene(backdrop->boundingRect()).contains(scenePos))
+            return backdrop;
+    }
+    return nullptr;
+}
+
+bool BlurService::hasSurfacesBehind(QQuickItem *item, const QRectF &sceneRect) const
+{
+    // Compare the stacking of the owning window, the item is part of it
+    QQuickItem *stacked = item;
+    for (auto parent = item->parentItem(); parent; parent = parent->parentItem()) {
+        if (qobject_cast<SurfaceWrapper *>(parent)) {
+            stacked = parent;
+            break;
+        }
+    }
+
+    const auto &surfaces = Helper::instance()->rootContainer()->surfaces();
+    for (auto surface : surfaces) {
+        if (surface == stacked || !surface->isVisible()
+            || surface->type() == SurfaceWrapper::Type::Layer)
+            continue;
+        if (!surface->mapRectToScene(QRectF(QPointF(), surface->size())).intersects(sceneRect))
+            continue;
+        if (isStackedBelow(surface, stacked))
+            return true;
+    }
+    return false;
+}
+
+quint64 BlurService::surfacesSerial() const
+{
+    return m_surfacesSerial;
+}
+
+void BlurService::onSurfaceAdded(SurfaceWrapper *surface)
+{
+    if (surface->type() == SurfaceWrapper::Type::Layer)
+        return;
+
+    connect(surface, &SurfaceWrapper::geometryChanged, this, &BlurService::invalidateSurfaces);
+    connect(surface, &QQuickItem::visibleChanged, this, &BlurService::invalidateSurfaces);
+    connect(surface, &QQuickItem::zChanged, this, &BlurService::invalidateSurfaces);
+    connect(surface, &SurfaceWrapper::stackingChanged, this, &BlurService::invalidateSurfaces);
+    invalidateSurfaces();
+}
+
+void BlurService::onSurfaceRemoved(SurfaceWrapper *surface)
+{
+    surface->disconnect(this);
+    invalidateSurfaces();
+}
+
+void BlurService::invalidateSurfaces()
+{
+    ++m_surfacesSerial;
+}
+
+BackdropBlur::BackdropBlur(QQuickItem *parent)
+    : TQuickRadiusEffect(parent)
+{
+    connect(this, &TQuickRadiusEffect::sourceItemChanged, this, &BackdropBlur::availableChanged);
+}
+
+bool BackdropBlur::available() const
+{
+    return sourceItem();
+}
+
+void BackdropBlur::itemChange(ItemChange change, const ItemChangeData &value)
+{
+    TQuickRadiusEffect::itemChange(change, value);
+
+    if (change != ItemSceneChange)
+        return;
+
+    QObject::disconnect(m_frameConnection);
+    if (value.window) {
+        // Ancestors move without telling us, so follow them once per frame
+        m_frameConnection = connect(value.window,
+                                    &QQuickWindow::afterAnimating,
+                                    this,
+                                    &BackdropBlur::updateBackdrop);
+        updateBackdrop();
+    }
+}
+
+void BackdropBlur::updateBackdrop()
+{
+    auto service = Helper::instance()->blurService();
+    if (!service)
+        return;
+
+    const QRectF rect = boundingRect();
+    const QRectF sceneRect = mapRectToScene(rect);
+    auto backdrop = service->backdropAt(sceneRect.center());
+    if (backdrop) {
+        if (sceneRect != m_checkedRect || service->surfacesSerial() != m_checkedSerial) {
+            m_checkedRect = sceneRect;
+            m_checkedSerial = service->surfacesSerial();
+            m_surfacesBehind = service->hasSurfacesBehind(this, sceneRect);
+        }
+        if (m_surfacesBehind)
+            backdrop = nullptr;
+    }
+    if (backdrop != sourceItem())
+        setSourceItem(backdrop);
+    if (!backdrop || backdrop->width() <= 0 || backdrop->height() <= 0)
+        return;
+
+    const QRectF mapped = mapRectToItem(backdrop, rect);
+    setSourceRect(QRectF(mapped.x() / backdrop->width(),
+                         mapped.y() / backdrop->height(),
+                         mapped.width() / backdrop->width(),
+                         mapped.height() / backdrop->height()));
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include "tquickradiuseffect.h"
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QQmlEngine>
+
+class SurfaceWrapper;
+
+// Keeps track of the blurred backdrop of every output. Each output blurs its
+// wallpaper once at reduced resolution (see BlurBackdrop.qml), the result is
+// only rendered again when the wallpaper changed, and every BackdropBlur samples
+// from it, so the cost no longer grows with the number of blurred items.
+// The backdrop holds no windows, items with windows behind them blur what is
+// really there with a RenderBufferBlitter of their own (see Blur.qml).
+class BlurService : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("BlurService is owned by Helper")
+
+public:
+    explicit BlurService(QObject *parent = nullptr);
+
+    // texture is a texture provider covering the whole output
+    Q_INVOKABLE void addBackdrop(QQuickItem *texture);
+    Q_INVOKABLE void removeBackdrop(QQuickItem *texture);
+
+    QQuickItem *backdropAt(const QPointF &scenePos) const;
+    // Whether a toplevel stacked below item, other than the one item belongs
+    // to, overlaps sceneRect. Layer surfaces don't count.
+    bool hasSurfacesBehind(QQuickItem *item, const QRectF &sceneRect) const;
+    // Bumped whenever a toplevel is added, removed, moved, shown, hidden
+    // or restacked, hasSurfacesBehind() only changes along with it
+    quint64 surfacesSerial() const;
+
+Q_SIGNALS:
+    void backdropsChanged();
+
+private:
+    void onSurfaceAdded(SurfaceWrapper *surface);
+    void onSurfaceRemoved(SurfaceWrapper *surface);
+    void invalidateSurfaces();
+
+    QList<QPointer<QQuickItem>> m_backdrops;
+    quint64 m_surfacesSerial = 1;
+};
+
+// Draws the part of the cached backdrop behind the item, with rounded corners
+class BackdropBlur : public TQuickRadiusEffect
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(bool available READ available NOTIFY availableChanged FINAL)
+
+public:
+    explicit BackdropBlur(QQuickItem *parent = nullptr);
+
+    // False when no output backdrop is under the item, or windows are
+    bool available() const;
+
+Q_SIGNALS:
+    void availableChanged();
+
+protected:
+    void itemChange(ItemChange change, const ItemChangeData &value) override;
+
+private:
+    void updateBackdrop();
+
+    QMetaObject::Connection m_frameConnection;
+    // What hasSurfacesBehind() returned for the scene rect and serial below
+    QRectF m_checkedRect;
+    quint64 m_checkedSerial = 0;
+    bool m_surfacesBehind = false;
+};
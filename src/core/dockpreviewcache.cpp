@@ -0,0 +1,207 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "core/dockpreviewcache.h"
+
+#include "surface/surfacewrapper.h"
+
+#include <wsurface.h>
+
+#include <qwcompositor.h>
+
+#include <QImage>
+#include <QMutex>
+#include <QQuickImageProvider>
+#include <QQuickItemGrabResult>
+#include <QQuickWindow>
+#include <QTimer>
+
+WAYLIB_SERVER_USE_NAMESPACE
+QW_USE_NAMESPACE
+
+// Matches the largest delegate of DockPreview.qml
+static constexpr QSizeF PreviewSize(240, 120);
+static constexpr int MinGrabInterval = 250;
+
+struct DockPreviewCache::Store
+{
+    QMutex mutex;
+    QHash<quint64, QImage> images;
+};
+
+namespace {
+class DockPreviewImageProvider : public QQuickImageProvider
+{
+public:
+    explicit DockPreviewImageProvider(std::shared_ptr<DockPreviewCache::Store> store)
+        : QQuickImageProvider(QQuickImageProvider::Image)
+        , m_store(std::move(store))
+    {
+    }
+
+    QImage requestImage(const QString &id, QSize *size, const QSize &requestedSize) override
+    {
+        // id is "<entry>/<serial>", the serial only defeats the url cache of Image
+        const quint64 key = id.section(u'/', 0, 0).toULongLong();
+
+        QImage image;
+        {
+            QMutexLocker locker(&m_store->mutex);
+            image = m_store->images.value(key);
+        }
+
+        if (size)
+            *size = image.size();
+        if (!image.isNull() && requestedSize.isValid() && requestedSize != image.size())
+            image = image.scaled(requestedSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        return image;
+    }
+
+private:
+    std::shared_ptr<DockPreviewCache::Store> m_store;
+};
+} // namespace
+
+DockPreviewCache::DockPreviewCache(QObject *parent)
+    : QObject(parent)
+    , m_store(std::make_shared<Store>())
+    , m_grabTimer(new QTimer(this))
+{
+    m_grabTimer->setSingleShot(true);
+    connect(m_grabTimer, &QTimer::timeout, this, &DockPreviewCache::grabPending);
+}
+
+DockPreviewCache::~DockPreviewCache()
+{
+    for (const auto &entry : std::as_const(m_entries))
+        QObject::disconnect(entry.commitConnection);
+}
+
+QQuickImageProvider *DockPreviewCache::createImageProvider() const
+{
+    return new DockPreviewImageProvider(m_store);
+}
+
+void DockPreviewCache::setShownSurfaces(const std::vector<SurfaceWrapper *> &surfaces)
+{
+    for (auto &entry : m_entries)
+        entry.shown = false;
+
+    for (auto surface : surfaces) {
+        auto &entry = ensureEntry(surface);
+        entry.shown = true;
+        if (entry.dirty)
+            requestGrab(surface);
+    }
+}
+
+QUrl DockPreviewCache::source(SurfaceWrapper *surface) const
+{
+    auto it = m_entries.constFind(surface);
+    if (it == m_entries.constEnd() || !it->serial)
+        return {};
+    return QUrl(QStringLiteral("image://%1/%2/%3")
+                    .arg(QLatin1StringView(ProviderId))
+                    .arg(it->id)
+                    .arg(it->serial));
+}
+
+DockPreviewCache::Entry &DockPreviewCache::ensureEntry(SurfaceWrapper *surface)
+{
+    auto it = m_entries.find(surface);
+    if (it != m_entries.end())
+        return *it;
+
+    Entry entry;
+    entry.id = m_nextId++;
+    if (auto wsurface = surface->surface()) {
+        entry.commitConnection =
+            wsurface->handle()->safeConnect(&qw_surface::notify_commit, this, [this, surface] {
+                onCommitted(surface);
+            });
+    }
+    connect(surface, &SurfaceWrapper::destroyed, this, [this, surface] {
+        removeEntry(surface);
+    });
+
+    return *m_entries.insert(surface, entry);
+}
+
+void DockPreviewCache::removeEntry(SurfaceWrapper *surface)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end())
+        return;
+
+    QObject::disconnect(it->commitConnection);
+    {
+        QMutexLocker locker(&m_store->mutex);
+        m_store->images.remove(it->id);
+    }
+    m_entries.erase(it);
+}
+
+void DockPreviewCache::onCommitted(SurfaceWrapper *surface)
+{
+    auto it = m_entries.find(surface);
+    if (it == m_entries.end())
+        return;
+
+    it->dirty = true;
+    if (it->shown)
+        requestGrab(surface);
+}
+
+void DockPreviewCache::requestGrab(SurfaceWrapper *surface)
+{
+    auto &entry = m_entries[surface];
+    // Picked up again once the running grab is ready
+    if (entry.grab)
+        return;
+
+    if (entry.lastGrab.isValid() && entry.lastGrab.elapsed() < MinGrabInterval) {
+        const int remaining = MinGrabInterval - entry.lastGrab.elapsed();
+        if (!m_grabTimer->isActive() || m_grabTimer->remainingTime() > remaining)
+            m_grabTimer->start(remaining);
+        return;
+    }
+
+    if (surface->size().isEmpty() || !surface->window())
+        return;
+
+    const qreal dpr = surface->window()->effectiveDevicePixelRatio();
+    QSizeF targetSize = surface->size();
+    targetSize.scale(PreviewSize * dpr, Qt::KeepAspectRatio);
+
+    auto grab = surface->grabToImage(targetSize.toSize());
+    if (!grab)
+        return;
+
+    entry.dirty = false;
+    entry.lastGrab.start();
+    entry.grab = grab;
+    connect(grab.data(), &QQuickItemGrabResult::ready, this, [this, surface] {
+        auto it = m_entries.find(surface);
+        if (it == m_entries.end())
+            return;
+
+        const auto grab = std::exchange(it->grab, {});
+        {
+            QMutexLocker locker(&m_store->mutex);
+            m_store->images.insert(it->id, grab->image());
+        }
+        ++it->serial;
+        Q_EMIT previewUpdated(surface);
+
+        if (it->dirty && it->shown)
+            requestGrab(surface);
+    });
+}
+
+void DockPreviewCache::grabPending()
+{
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (it->dirty && it->shown)
+            requestGrab(it.key());
+    }
+}
@@ -0,0 +1,74 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QQmlEngine>
+#include <QSharedPointer>
+#include <QUrl>
+
+#include <memory>
+#include <vector>
+
+Q_MOC_INCLUDE("surface/surfacewrapper.h")
+
+QT_BEGIN_NAMESPACE
+class QQuickImageProvider;
+class QQuickItemGrabResult;
+class QTimer;
+QT_END_NAMESPACE
+
+class SurfaceWrapper;
+
+// Keeps a small image of every window that has been shown in the dock preview.
+// Images are grabbed again after the client commits, at most once per
+// MinGrabInterval, and only while the window is shown in the preview.
+class DockPreviewCache : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("DockPreviewCache is owned by Helper")
+
+public:
+    static constexpr const char *ProviderId = "dockpreview";
+    struct Store;
+
+    explicit DockPreviewCache(QObject *parent = nullptr);
+    ~DockPreviewCache() override;
+
+    // Owned by the engine once added with QQmlEngine::addImageProvider
+    QQuickImageProvider *createImageProvider() const;
+
+    void setShownSurfaces(const std::vector<SurfaceWrapper *> &surfaces);
+
+    // An image:// url for the cached preview, empty before the first grab finished
+    Q_INVOKABLE QUrl source(SurfaceWrapper *surface) const;
+
+Q_SIGNALS:
+    void previewUpdated(SurfaceWrapper *surface);
+
+private:
+    struct Entry
+    {
+        quint64 id = 0;
+        quint64 serial = 0;
+        QElapsedTimer lastGrab;
+        QSharedPointer<QQuickItemGrabResult> grab;
+        QMetaObject::Connection commitConnection;
+        bool dirty = true;
+        bool shown = false;
+    };
+
+    Entry &ensureEntry(SurfaceWrapper *surface);
+    void removeEntry(SurfaceWrapper *surface);
+    void onCommitted(SurfaceWrapper *surface);
+    void requestGrab(SurfaceWrapper *surface);
+    void grabPending();
+
+    QHash<SurfaceWrapper *, Entry> m_entries;
+    std::shared_ptr<Store> m_store;
+    QTimer *m_grabTimer;
+    quint64 m_nextId = 1;
+};
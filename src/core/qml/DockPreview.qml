@@ -497,6 +497,26 @@ Item {
                 }
             }
 
+            property url previewSource: Helper.dockPreviewCache.source(wrapper)
+
+            Connections {
+                target: Helper.dockPreviewCache
+                function onPreviewUpdated(surface) {
+                    if (surface === delegate.wrapper)
+                        delegate.previewSource = Helper.dockPreviewCache.source(delegate.wrapper)
+                }
+            }
+
+            Image {
+                id: preview
+                anchors.fill: effect
+                source: delegate.previewSource
+                cache: false
+                smooth: true
+                visible: status === Image.Ready
+            }
+
+            // Only until the first cached image of the window is ready
             ShaderEffectSource {
                 id: effect
                 anchors.centerIn: parent
@@ -505,7 +525,8 @@ Item {
                 live: true
                 hideSource: false
                 smooth: true
-                sourceItem: wrapper
+                sourceItem: preview.visible ? null : wrapper
+                visible: !preview.visible
             }
         }
 
@@ -7,44 +7,72 @@ import QtQuick.Shapes
 import Waylib.Server
 import Treeland
 
-RenderBufferBlitter {
+Item {
+    id: root
+
     property real radius: 0
     property bool radiusEnabled: radius > 0
-    property alias blurMax: blur.blurMax
-    property alias blurEnabled: blur.blurEnabled
-    property alias multiplier: blur.blurMultiplier
+    property bool blurEnabled: true
 
-    id: blitter
     z: parent.z ? parent.z - 1 : -1
     anchors.fill: parent
-    MultiEffect {
-        id: blur
+
+    BackdropBlur {
+        id: cached
         anchors.fill: parent
-        layer.enabled: blitter.radiusEnabled
-        smooth: blitter.radiusEnabled
-        opacity: blitter.radiusEnabled ? 0 : parent.opacity
-        source: blitter.content
-        autoPaddingEnabled: false
-        blurEnabled: true
-        blur: 1.0
-        blurMax: 64
-        saturation: 0.2
+        visible: available && root.blurEnabled
+        radius: root.radiusEnabled ? root.radius : 0
+        onAvailableChanged: {
+            if (!available)
+                fallback.active = true
+        }
+        Component.onCompleted: {
+            if (!available)
+                fallback.active = true
+        }
     }
 
+    // Blurs what is really behind the item, windows included, every frame.
+    // Created the first time it is needed and then only hidden, windows
+    // moving in and out from behind must not rebuild it each time.
     Loader {
-        x: blur.x
-        y: blur.y
-        active: blitter.radiusEnabled
-        sourceComponent: Shape {
+        id: fallback
+        anchors.fill: parent
+        active: false
+        visible: !cached.available
+        sourceComponent: RenderBufferBlitter {
+            id: blitter
             anchors.fill: parent
-            preferredRendererType: Shape.CurveRenderer
-            ShapePath {
-                strokeWidth: 0
-                fillItem: blur
-                PathRectangle {
-                    width: blur.width
-                    height: blur.height
-                    radius: blitter.radius
+            MultiEffect {
+                id: blur
+                anchors.fill: parent
+                layer.enabled: root.radiusEnabled
+                smooth: root.radiusEnabled
+                opacity: root.radiusEnabled ? 0 : parent.opacity
+                source: blitter.content
+                autoPaddingEnabled: false
+                blurEnabled: root.blurEnabled
+                blur: 1.0
+                blurMax: 64
+                saturation: 0.2
+            }
+
+            Loader {
+                x: blur.x
+                y: blur.y
+                active: root.radiusEnabled
+                sourceComponent: Shape {
+                    anchors.fill: parent
+                    preferredRendererType: Shape.CurveRenderer
+                    ShapePath {
+                        strokeWidth: 0
+                        fillItem: blur
+                        PathRectangle {
+                            width: blur.width
+                            height: blur.height
+                            radius: root.radius
+                        }
+                    }
                 }
             }
         }
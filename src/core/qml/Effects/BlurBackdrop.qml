@@ -0,0 +1,113 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+import QtQuick
+import Treeland
+
+// Dual Kawase blur of sourceItem, shared by every Blur on this output. The source
+// is captured at half resolution and only rendered again when it changed. The
+// software backend has no shaders, there a box blur runs on the CPU instead.
+Item {
+    id: root
+
+    required property Item sourceItem
+    property real devicePixelRatio: 1
+    // Distance of the samples in texels, higher is blurrier
+    property real offset: 2
+    property real saturation: 0.2
+    readonly property bool software: GraphicsInfo.api === GraphicsInfo.Software
+
+    function textureSize(divisor) {
+        return Qt.size(Math.max(1, Math.ceil(width * devicePixelRatio / divisor)),
+                       Math.max(1, Math.ceil(height * devicePixelRatio / divisor)))
+    }
+
+    component Pass: ShaderEffectSource {
+        id: pass
+
+        required property ShaderEffectSource input
+        required property int divisor
+        required property url shader
+        property real saturation: 0
+
+        width: root.width
+        height: root.height
+        visible: false
+        hideSource: true
+        smooth: true
+        textureSize: root.textureSize(divisor)
+        sourceItem: ShaderEffect {
+            readonly property ShaderEffectSource source: pass.input
+            readonly property vector2d halfPixel: Qt.vector2d(root.offset * 0.5 / pass.input.textureSize.width,
+                                                              root.offset * 0.5 / pass.input.textureSize.height)
+            readonly property real saturation: pass.saturation
+
+            width: pass.width
+            height: pass.height
+            fragmentShader: pass.shader
+        }
+    }
+
+    // Damage is per texture: the scene graph only tells a layer that something
+    // in its subtree changed, so any change redoes the whole chain
+    ShaderEffectSource {
+        id: capture
+
+        width: root.width
+        height: root.height
+        visible: false
+        smooth: true
+        sourceItem: root.sourceItem
+        // The CPU blur is cheaper on fewer pixels and looks the same
+        textureSize: root.textureSize(root.software ? 4 : 2)
+    }
+
+    Component {
+        id: kawaseBlur
+
+        Item {
+            readonly property Item result: blurred
+
+            Pass { id: down1; input: capture; divisor: 4; shader: "qrc:/shaders/kawasedown.frag.qsb" }
+            Pass { id: down2; input: down1; divisor: 8; shader: "qrc:/shaders/kawasedown.frag.qsb" }
+            Pass { id: down3; input: down2; divisor: 16; shader: "qrc:/shaders/kawasedown.frag.qsb" }
+            Pass { id: up1; input: down3; divisor: 8; shader: "qrc:/shaders/kawaseup.frag.qsb" }
+            Pass { id: up2; input: up1; divisor: 4; shader: "qrc:/shaders/kawaseup.frag.qsb" }
+            Pass {
+                id: blurred
+                input: up2
+                divisor: 2
+                shader: "qrc:/shaders/kawaseup.frag.qsb"
+                saturation: root.saturation
+            }
+        }
+    }
+
+    Component {
+        id: softwareBlur
+
+        TSoftwareBlur {
+            id: blurred
+
+            readonly property Item result: blurred
+
+            width: root.width
+            height: root.height
+            visible: false
+            sourceItem: capture
+            radius: Math.max(1, Math.round(root.offset * 2))
+        }
+    }
+
+    Loader {
+        id: blur
+
+        sourceComponent: root.software ? softwareBlur : kawaseBlur
+        onLoaded: Helper.blurService.addBackdrop(item.result)
+    }
+
+    Component.onDestruction: {
+        if (blur.item)
+            Helper.blurService.removeBackdrop(blur.item.result)
+    }
+}
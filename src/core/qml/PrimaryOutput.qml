@@ -11,6 +11,9 @@ OutputItem {
     readonly property OutputViewport screenViewport: outputViewport
     property alias wallpaperVisible: wallpaper.visible
     property bool forceSoftwareCursor: false
+    // Set while this output mirrors another one, see Output::setProxy
+    property PrimaryOutput targetOutputItem: null
+    readonly property bool mirroring: targetOutputItem !== null
 
     devicePixelRatio: output?.scale ?? devicePixelRatio
 
@@ -24,7 +27,7 @@ OutputItem {
         output: outputCursor.output.output
         x: position.x - hotSpot.x
         y: position.y - hotSpot.y
-        visible: valid && outputCursor.visible
+        visible: valid && outputCursor.visible && !rootOutputItem.mirroring
         OutputLayer.enabled: !outputCursor.output.forceSoftwareCursor
         OutputLayer.keepLayer: true
         OutputLayer.outputs: [screenViewport]
@@ -42,6 +45,21 @@ OutputItem {
         devicePixelRatio: parent.devicePixelRatio
         anchors.centerIn: parent
 
+        // While mirroring only the scaled primary viewport is shown, unless
+        // OutputMirror presents its buffers as they are
+        Binding on input {
+            when: rootOutputItem.mirroring
+            value: mirrorContent
+        }
+        Binding on depends {
+            when: rootOutputItem.mirroring
+            value: rootOutputItem.mirroring ? [rootOutputItem.targetOutputItem.screenViewport] : []
+        }
+        Binding on ignoreViewport {
+            when: rootOutputItem.mirroring
+            value: true
+        }
+
         RotationAnimation {
             id: rotationAnimator
 
@@ -83,8 +101,36 @@ OutputItem {
     }
 
     Item {
+        id: mirrorContent
+        anchors.fill: parent
+        visible: rootOutputItem.mirroring
+
+        TextureProxy {
+            objectName: "mirrorProxy"
+            sourceItem: rootOutputItem.targetOutputItem?.screenViewport ?? null
+            anchors.centerIn: parent
+            rotation: sourceItem?.rotation ?? 0
+            width: sourceItem?.implicitWidth ?? 0
+            height: sourceItem?.implicitHeight ?? 0
+            smooth: true
+            transformOrigin: Item.Center
+            scale: {
+                if (!rootOutputItem.mirroring)
+                    return 1;
+                const target = rootOutputItem.targetOutputItem;
+                const isize = Qt.size(target.width, target.height);
+                const osize = Qt.size(rootOutputItem.width, rootOutputItem.height);
+                const size = WaylibHelper.scaleSize(isize, osize, Qt.KeepAspectRatio);
+                return size.width / isize.width;
+            }
+        }
+    }
+
+    Item {
+        id: wallpaperContainer
         clip: true
         anchors.fill: parent
+        visible: !rootOutputItem.mirroring
         Wallpaper {
             id: wallpaper
             output: rootOutputItem.output
@@ -134,6 +180,13 @@ OutputItem {
         }
     }
 
+    BlurBackdrop {
+        anchors.fill: parent
+        visible: !rootOutputItem.mirroring
+        sourceItem: wallpaperContainer
+        devicePixelRatio: rootOutputItem.devicePixelRatio
+    }
+
     function setTransform(transform) {
         screenViewport.rotationOutput(transform)
     }
@@ -89,7 +89,7 @@ Item {
 
                 SurfaceProxy {
                     id: proxy
-                    live: true
+                    live: sourceView.liveThumbnails
                     anchors.centerIn: parent
                     surface: windowItem.surface
                     maxSize: Qt.size(parent.width, parent.height)
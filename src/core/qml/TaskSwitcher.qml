@@ -12,7 +12,8 @@ Item {
     id: root
     visible: false
 
-    property bool switchOn: true
+    // The switcher is kept hidden between uses, enter() starts a switch
+    property bool switchOn: false
     property int focusReason: Qt.TabFocusReason
     required property QtObject output
     readonly property QtObject model: Helper.workspace.currentFilter
@@ -33,6 +34,14 @@ Item {
     width: output.validRect.width
     height: output.validRect.height
 
+    onSwitchOnChanged: {
+        if (!switchOn) {
+            // Don't keep the previews of the last switch alive
+            previewContext.sourceComponent = undefined
+            currentContext.sourceComponent = undefined
+        }
+    }
+
     onVisibleChanged: {
         if (visible) {
             mask.opacity = 0.5
@@ -68,12 +77,6 @@ Item {
                 easing.type: Easing.OutExpo
             }
         }
-
-        Component.onCompleted: {
-            Qt.callLater(() => {
-                mask.opacity = 0.5
-            })
-        }
     }
 
     MouseArea {
@@ -201,6 +204,8 @@ Item {
                 readonly property real delegateMaxWidth: 260
                 readonly property real separatorHeight: 1
                 readonly property real radius: root.enableRadius ? 20 : 0
+                // thumbnails keep their last content while the switcher is hidden
+                readonly property bool liveThumbnails: root.visible
 
                 // control listview delegate and highlight
                 property bool enableDelegateBlur: root.enableBlur
@@ -232,24 +237,11 @@ Item {
                 }
                 highlight: SwitchViewHighlightDelegate {}
                 highlightFollowsCurrentItem: false
-
-                Component.onCompleted: {
-                    if (root.model.activeIndex >= 0 && root.model.activeIndex < switchView.count)
-                        switchView.currentIndex = root.model.activeIndex;
-                    else {
-                        switchView.currentIndex = switchView.count > 1 ? 1 : 0
-                    }
-                }
             }
         }
 
         Component.onCompleted: {
-            if (root.enableAnimation) {
-                switchItemAnimation.fromeY = switchItem.y
-                switchItemAnimation.stop()
-                switchItemAnimation.isInAni = true
-                switchItemAnimation.start()
-            }
+            switchItemAnimation.fromeY = switchItem.y
         }
     }
 
@@ -418,6 +410,19 @@ Item {
         }
     }
 
+    function enter() {
+        if (!switchItemAnimation.running)
+            switchItemAnimation.fromeY = switchItem.y
+
+        if (root.model.activeIndex >= 0 && root.model.activeIndex < switchView.count)
+            switchView.currentIndex = root.model.activeIndex;
+        else {
+            switchView.currentIndex = switchView.count > 1 ? 1 : 0
+        }
+
+        root.switchOn = true
+    }
+
     function previous() {
         if (switchView.count <= 1) {
             if (switchView.count === 1) {
@@ -34,25 +34,72 @@ Item {
                 lock: true
             }
 
-            Row {
+            Item {
                 x: - Helper.workspace.animationController.viewportPos * animationDelegate.localAnimationScaleFactor
-                spacing: Helper.workspace.animationController.refGap * animationDelegate.localAnimationScaleFactor
                 Repeater {
                     model: Helper.workspace.models
+                    // Every workspace keeps its slot, only the content of the
+                    // ones in the viewport is created
                     delegate: Item {
-                        width: animationDelegate.output.outputItem.width
-                        height: animationDelegate.output.outputItem.height
                         id: workspaceDelegate
+                        required property int index
                         required property WorkspaceModel workspace
-                        ShaderEffectSource {
-                            id: wallpaperShot
-                            sourceItem: wpCtrl.proxy
-                            hideSource: false
+                        readonly property real refPos: index * (Helper.workspace.animationController.refWidth
+                                                                + Helper.workspace.animationController.refGap)
+                        readonly property bool inViewport: refPos < Helper.workspace.animationController.viewportPos
+                                                           + Helper.workspace.animationController.refWidth
+                                                           && refPos + Helper.workspace.animationController.refWidth
+                                                           > Helper.workspace.animationController.viewportPos
+                        // Set once the proxy has been rendered into the snapshot
+                        property bool frozen: false
+
+                        x: refPos * animationDelegate.localAnimationScaleFactor
+                        width: animationDelegate.output.outputItem.width
+                        height: animationDelegate.output.outputItem.height
+
+                        onInViewportChanged: {
+                            if (inViewport)
+                                frozen = false
+                        }
+
+                        Connections {
+                            target: workspaceDelegate.Window.window
+                            enabled: workspaceDelegate.inViewport && !workspaceDelegate.frozen
+                                     && proxyLoader.status === Loader.Ready
+                            function onFrameSwapped() {
+                                workspaceDelegate.frozen = true
+                            }
+                        }
+
+                        Item {
+                            id: content
                             anchors.fill: parent
+
+                            ShaderEffectSource {
+                                id: wallpaperShot
+                                sourceItem: wpCtrl.proxy
+                                hideSource: false
+                                anchors.fill: parent
+                            }
+                            Loader {
+                                id: proxyLoader
+                                active: workspaceDelegate.inViewport
+                                sourceComponent: WorkspaceProxy {
+                                    workspace: workspaceDelegate.workspace
+                                    output: animationDelegate.output
+                                }
+                            }
                         }
-                        WorkspaceProxy {
-                            workspace: workspaceDelegate.workspace
-                            output: animationDelegate.output
+
+                        // The windows are rendered once when the workspace slides in,
+                        // the slide itself only moves this texture
+                        ShaderEffectSource {
+                            id: snapshot
+                            anchors.fill: parent
+                            visible: workspaceDelegate.inViewport
+                            sourceItem: content
+                            hideSource: true
+                            live: !workspaceDelegate.frozen
                         }
                     }
                 }
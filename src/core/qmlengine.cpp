@@ -25,21 +25,17 @@ QmlEngine::QmlEngine(QObject *parent)
     , surfaceContent(this, "Treeland", "SurfaceContent")
     , xdgShadowComponent(this, "Treeland", "XdgShadow")
     , taskSwitchComponent(this, "Treeland", "TaskSwitcher")
-    , geometryAnimationComponent(this, "Treeland", "GeometryAnimation")
     , menuBarComponent(this, "Treeland", "OutputMenuBar")
     , workspaceSwitcher(this, "Treeland", "WorkspaceSwitcher")
-    , newAnimationComponent(this, "Treeland", "NewAnimation")
 #ifndef DISABLE_DDM
     , lockScreenComponent(this, "Treeland", "Greeter")
 #endif
     , dockPreviewComponent(this, "Treeland", "DockPreview")
     , minimizeAnimationComponent(this, "Treeland", "MinimizeAnimation")
-    , showDesktopAnimatioComponentn(this, "Treeland", "ShowDesktopAnimation")
     , captureSelectorComponent(this, "Treeland", "CaptureSelectorLayer")
     , windowPickerComponent(this, "Treeland", "WindowPickerLayer")
-    , launchpadAnimationComponent(this, "Treeland", "LaunchpadAnimation")
     , launchpadCoverComponent(this, "Treeland", "LaunchpadCover")
-    , layershellAnimationComponent(this, "Treeland", "LayerShellAnimation")
+    , blurComponent(this, "Treeland", "Blur")
 {
 }
 
@@ -115,20 +111,6 @@ QQuickItem *QmlEngine::createTaskSwitcher(Output *output, QQuickItem *parent)
                            { { "output", QVariant::fromValue(output) } });
 }
 
-QQuickItem *QmlEngine::createGeometryAnimation(SurfaceWrapper *surface,
-                                               const QRectF &startGeo,
-                                               const QRectF &endGeo,
-                                               QQuickItem *parent)
-{
-    return createComponent(geometryAnimationComponent,
-                           parent,
-                           {
-                               { "surface", QVariant::fromValue(surface) },
-                               { "fromGeometry", QVariant::fromValue(startGeo) },
-                               { "toGeometry", QVariant::fromValue(endGeo) },
-                           });
-}
-
 QQuickItem *QmlEngine::createMenuBar(WOutputItem *output, QQuickItem *parent)
 {
     return createComponent(menuBarComponent, parent, { { "output", QVariant::fromValue(output) } });
@@ -139,30 +121,6 @@ QQuickItem *QmlEngine::createWorkspaceSwitcher(Workspace *parent)
     return createComponent(workspaceSwitcher, parent);
 }
 
-QQuickItem *QmlEngine::createNewAnimation(SurfaceWrapper *surface,
-                                          QQuickItem *parent,
-                                          uint direction)
-{
-    return createComponent(newAnimationComponent,
-                           parent,
-                           {
-                               { "target", QVariant::fromValue(surface) },
-                               { "direction", QVariant::fromValue(direction) },
-                           });
-}
-
-QQuickItem *QmlEngine::createLaunchpadAnimation(SurfaceWrapper *surface,
-                                                uint direction,
-                                                QQuickItem *parent)
-{
-    return createComponent(launchpadAnimationComponent,
-                           parent,
-                           {
-                               { "target", QVariant::fromValue(surface) },
-                               { "direction", QVariant::fromValue(direction) },
-                           });
-}
-
 QQuickItem *QmlEngine::createLaunchpadCover(SurfaceWrapper *surface,
                                             Output *output,
                                             QQuickItem *parent)
@@ -173,18 +131,6 @@ QQuickItem *QmlEngine::createLaunchpadCover(SurfaceWrapper *surface,
                              { "output", QVariant::fromValue(output->output()) } });
 }
 
-QQuickItem *QmlEngine::createLayerShellAnimation(SurfaceWrapper *surface,
-                                                 QQuickItem *parent,
-                                                 uint direction)
-{
-    return createComponent(layershellAnimationComponent,
-                           parent,
-                           {
-                               { "target", QVariant::fromValue(surface) },
-                               { "direction", QVariant::fromValue(direction) },
-                           });
-}
-
 QQuickItem *QmlEngine::createDockPreview(QQuickItem *parent)
 {
     return createComponent(dockPreviewComponent, parent);
@@ -216,18 +162,6 @@ QQuickItem *QmlEngine::createMinimizeAnimation(SurfaceWrapper *surface,
                            });
 }
 
-QQuickItem *QmlEngine::createShowDesktopAnimation(SurfaceWrapper *surface,
-                                                  QQuickItem *parent,
-                                                  bool show)
-{
-    return createComponent(showDesktopAnimatioComponentn,
-                           parent,
-                           {
-                               { "target", QVariant::fromValue(surface) },
-                               { "showDesktop", QVariant::fromValue(show) },
-                           });
-}
-
 QQuickItem *QmlEngine::createCaptureSelector(QQuickItem *parent, CaptureManagerV1 *captureManager)
 {
     return createComponent(
@@ -241,3 +175,8 @@ QQuickItem *QmlEngine::createWindowPicker(QQuickItem *parent)
 {
     return createComponent(windowPickerComponent, parent);
 }
+
+QQuickItem *QmlEngine::createBlur(QQuickItem *parent, qreal radius)
+{
+    return createComponent(blurComponent, parent, { { "radius", QVariant::fromValue(radius) } });
+}
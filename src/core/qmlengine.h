@@ -40,29 +40,18 @@ public:
     QQuickItem *createTaskBar(Output *output, QQuickItem *parent);
     QQuickItem *createXdgShadow(QQuickItem *parent);
     QQuickItem *createTaskSwitcher(Output *output, QQuickItem *parent);
-    QQuickItem *createGeometryAnimation(SurfaceWrapper *surface,
-                                        const QRectF &startGeo,
-                                        const QRectF &endGeo,
-                                        QQuickItem *parent);
     QQuickItem *createMenuBar(WOutputItem *output, QQuickItem *parent);
     QQuickItem *createWorkspaceSwitcher(Workspace *parent);
-    QQuickItem *createNewAnimation(SurfaceWrapper *surface, QQuickItem *parent, uint direction);
-    QQuickItem *createLaunchpadAnimation(SurfaceWrapper *surface,
-                                         uint direction,
-                                         QQuickItem *parent);
     QQuickItem *createLaunchpadCover(SurfaceWrapper *surface, Output *output, QQuickItem *parent);
-    QQuickItem *createLayerShellAnimation(SurfaceWrapper *surface,
-                                          QQuickItem *parent,
-                                          uint direction);
     QQuickItem *createLockScreen(Output *output, QQuickItem *parent);
     QQuickItem *createMinimizeAnimation(SurfaceWrapper *surface,
                                         QQuickItem *parent,
                                         const QRectF &iconGeometry,
                                         uint direction);
     QQuickItem *createDockPreview(QQuickItem *parent);
-    QQuickItem *createShowDesktopAnimation(SurfaceWrapper *surface, QQuickItem *parent, bool show);
     QQuickItem *createCaptureSelector(QQuickItem *parent, CaptureManagerV1 *captureManager);
     QQuickItem *createWindowPicker(QQuickItem *parent);
+    QQuickItem *createBlur(QQuickItem *parent, qreal radius);
 
     QQmlComponent *surfaceContentComponent()
     {
@@ -78,19 +67,15 @@ private:
     QQmlComponent surfaceContent;
     QQmlComponent xdgShadowComponent;
     QQmlComponent taskSwitchComponent;
-    QQmlComponent geometryAnimationComponent;
     QQmlComponent menuBarComponent;
     QQmlComponent workspaceSwitcher;
-    QQmlComponent newAnimationComponent;
 #ifndef DISABLE_DDM
     QQmlComponent lockScreenComponent;
 #endif
     QQmlComponent dockPreviewComponent;
     QQmlComponent minimizeAnimationComponent;
-    QQmlComponent showDesktopAnimatioComponentn;
     QQmlComponent captureSelectorComponent;
     QQmlComponent windowPickerComponent;
-    QQmlComponent launchpadAnimationComponent;
     QQmlComponent launchpadCoverComponent;
-    QQmlComponent layershellAnimationComponent;
+    QQmlComponent blurComponent;
 };
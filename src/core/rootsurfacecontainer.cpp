@@ -4,7 +4,9 @@
 #include "rootsurfacecontainer.h"
 
 #include "output/output.h"
+#include "output/outputconfigstore.h"
 #include "seat/helper.h"
+#include "surface/configurethrottler.h"
 #include "surface/surfacewrapper.h"
 
 #include <wcursor.h>
@@ -97,8 +99,12 @@ SurfaceWrapper *RootSurfaceContainer::getSurface(WToplevelSurface *surface) cons
 
 void RootSurfaceContainer::destroyForSurface(SurfaceWrapper *wrapper)
 {
-    if (wrapper == moveResizeState.surface)
+    if (wrapper == moveResizeState.surface) {
+        // Don't configure a surface that is going away
+        delete moveResizeState.configureThrottler;
+        moveResizeState.configureThrottler = nullptr;
         endMoveResize();
+    }
 
     wrapper->markWrapperToRemoved();
 }
@@ -106,8 +112,15 @@ void RootSurfaceContainer::destroyForSurface(SurfaceWrapper *wrapper)
 void RootSurfaceContainer::addOutput(Output *output)
 {
     m_outputModel->addObject(output);
-    m_outputLayout->autoAdd(output->output());
-    if (!m_primaryOutput)
+    // Restores the layout the user arranged last time
+    const OutputConfigStore store;
+    const QString identity = OutputConfigStore::identity(output->output());
+    const auto config = store.config(identity);
+    if (config)
+        m_outputLayout->add(output->output(), config->position);
+    else
+        m_outputLayout->autoAdd(output->output());
+    if (!m_primaryOutput || store.isPrimary(identity))
         setPrimaryOutput(output);
 
     SurfaceContainer::addOutput(output);
@@ -153,6 +166,8 @@ void RootSurfaceContainer::beginMoveResize(SurfaceWrapper *surface, Qt::Edges ed
     moveResizeState.surface = surface;
     moveResizeState.startGeometry = surface->geometry();
     moveResizeState.resizeEdges = edges;
+    if (edges)
+        moveResizeState.configureThrottler = new ConfigureThrottler(surface);
     surface->setXwaylandPositionFromSurface(false);
     surface->setPositionAutomatic(false);
 }
@@ -174,7 +189,8 @@ void RootSurfaceContainer::doMoveResize(const QPointF &incrementPos)
         if (moveResizeState.resizeEdges & Qt::BottomEdge)
             geo.setBottom(geo.bottom() + incrementPos.y());
 
-        moveResizeState.surface->resize(geo.size());
+        // Slow clients would lag behind a flood of configures from high rate pointers
+        moveResizeState.configureThrottler->resize(geo.size());
     } else {
         auto new_pos = moveResizeState.startGeometry.topLeft() + incrementPos;
         moveResizeState.surface->setPosition(new_pos);
@@ -193,6 +209,16 @@ void RootSurfaceContainer::endMoveResize()
     if (!moveResizeState.surface)
         return;
 
+    if (moveResizeState.configureThrottler) {
+        // The final size must reach the client even if it is still busy
+        moveResizeState.configureThrottler->flush();
+        delete moveResizeState.configureThrottler;
+        moveResizeState.configureThrottler = nullptr;
+    }
+
+    // Outputs of the surface are updated with the deferred geometry notification
+    moveResizeState.surface->flushGeometryChanges();
+
     auto o = moveResizeState.surface->ownsOutput();
     moveResizeState.surface->shellSurface()->setResizeing(false);
 
@@ -18,6 +18,8 @@ WAYLIB_SERVER_END_NAMESPACE
 
 WAYLIB_SERVER_USE_NAMESPACE
 
+class ConfigureThrottler;
+
 class OutputListModel : public ObjectListModel<Output>
 {
     Q_OBJECT
@@ -114,6 +116,7 @@ private:
     struct
     {
         SurfaceWrapper *surface = nullptr;
+        ConfigureThrottler *configureThrottler = nullptr;
         QRectF startGeometry;
         Qt::Edges resizeEdges;
         bool setSurfacePositionForAnchorEdgets = false;
@@ -5,6 +5,7 @@
 
 #include "tquickradiuseffect_p.h"
 #include "tsgradiusimagenode.h"
+#include "tsgsoftwareradiusnode.h"
 
 Q_LOGGING_CATEGORY(qLcEffect, "treeland.shader.radiusEffect")
 
@@ -358,8 +359,28 @@ QSGNode *TQuickRadiusEffect::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeDa
     auto sgRendererInterface = d->window->rendererInterface();
     if (sgRendererInterface
         && sgRendererInterface->graphicsApi() == QSGRendererInterface::Software) {
-        // TODO: Software is not currently supported
-        return nullptr;
+        TSGSoftwareRadiusNode *node = static_cast<TSGSoftwareRadiusNode *>(oldNode);
+        if (Q_LIKELY(!node)) {
+            node = new TSGSoftwareRadiusNode(window());
+        }
+        node->setTextureProvider(d->sourceItem->textureProvider());
+        node->setRect(boundingRect());
+        node->setSourceRect(d->sourceRect);
+        node->setRadius(d->radius);
+        if (Q_LIKELY(d->extraRadius.isAllocated())) {
+            node->setTopLeftRadius(d->extraRadius.value().topLeftRadius);
+            node->setTopRightRadius(d->extraRadius.value().topRightRadius);
+            node->setBottomLeftRadius(d->extraRadius.value().bottomLeftRadius);
+            node->setBottomRightRadius(d->extraRadius.value().bottomRightRadius);
+        } else {
+            node->setTopLeftRadius(-1.);
+            node->setTopRightRadius(-1.);
+            node->setBottomLeftRadius(-1.);
+            node->setBottomRightRadius(-1.);
+        }
+        node->markDirty(QSGNode::DirtyMaterial);
+
+        return node;
     } else {
         TSGRadiusImageNode *node = static_cast<TSGRadiusImageNode *>(oldNode);
         if (Q_LIKELY(!node)) {
@@ -367,6 +388,7 @@ QSGNode *TQuickRadiusEffect::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeDa
         }
         node->setTextureProvider(d->sourceItem->textureProvider());
         node->setRect(boundingRect());
+        node->setSourceRect(d->sourceRect);
         node->setRadius(d->radius);
         if (Q_LIKELY(d->extraRadius.isAllocated())) {
             node->setTopLeftRadius(d->extraRadius.value().topLeftRadius);
@@ -399,6 +421,24 @@ void TQuickRadiusEffect::itemChange(ItemChange change, const ItemChangeData &val
     QQuickItem::itemChange(change, value);
 }
 
+QRectF TQuickRadiusEffect::sourceRect() const
+{
+    Q_D(const TQuickRadiusEffect);
+
+    return d->sourceRect;
+}
+
+void TQuickRadiusEffect::setSourceRect(const QRectF &rect)
+{
+    Q_D(TQuickRadiusEffect);
+
+    if (d->sourceRect == rect)
+        return;
+
+    d->sourceRect = rect;
+    update();
+}
+
 TQuickRadiusEffect::TQuickRadiusEffect(TQuickRadiusEffectPrivate &dd, QQuickItem *parent)
     : QQuickItem(dd, parent)
 {
@@ -60,6 +60,9 @@ private Q_SLOTS:
 protected:
     QSGNode *updatePaintNode(QSGNode *, UpdatePaintNodeData *) override;
     void itemChange(ItemChange change, const ItemChangeData &value) override;
+    // Normalized part of the source texture that is drawn, all of it by default
+    QRectF sourceRect() const;
+    void setSourceRect(const QRectF &rect);
     TQuickRadiusEffect(TQuickRadiusEffectPrivate &dd, QQuickItem *parent = nullptr);
 
 private:
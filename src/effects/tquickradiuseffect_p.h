@@ -45,4 +45,5 @@ public:
     uint hideSource : 1;
     QLazilyAllocated<ExtraData> extraRadius;
     qreal radius;
+    QRectF sourceRect = QRectF(0, 0, 1, 1);
 };
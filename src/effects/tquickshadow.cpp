@@ -0,0 +1,223 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tquickshadow.h"
+
+#include "tshadowcache.h"
+
+#include <QQuickWindow>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
+#include <QSGTextureMaterial>
+
+TQuickShadow::TQuickShadow(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents);
+}
+
+qreal TQuickShadow::cornerRadius() const
+{
+    return m_cornerRadius;
+}
+
+void TQuickShadow::setCornerRadius(qreal radius)
+{
+    if (qFuzzyCompare(m_cornerRadius, radius))
+        return;
+
+    m_cornerRadius = radius;
+    update();
+    Q_EMIT cornerRadiusChanged();
+}
+
+qreal TQuickShadow::shadowBlur() const
+{
+    return m_shadowBlur;
+}
+
+void TQuickShadow::setShadowBlur(qreal blur)
+{
+    if (qFuzzyCompare(m_shadowBlur, blur))
+        return;
+
+    m_shadowBlur = blur;
+    update();
+    Q_EMIT shadowBlurChanged();
+}
+
+qreal TQuickShadow::shadowOffsetY() const
+{
+    return m_shadowOffsetY;
+}
+
+void TQuickShadow::setShadowOffsetY(qreal offset)
+{
+    if (qFuzzyCompare(m_shadowOffsetY, offset))
+        return;
+
+    m_shadowOffsetY = offset;
+    update();
+    Q_EMIT shadowOffsetYChanged();
+}
+
+QColor TQuickShadow::shadowColor() const
+{
+    return m_shadowColor;
+}
+
+void TQuickShadow::setShadowColor(const QColor &color)
+{
+    if (m_shadowColor == color)
+        return;
+
+    m_shadowColor = color;
+    update();
+    Q_EMIT shadowColorChanged();
+}
+
+bool TQuickShadow::hollow() const
+{
+    return m_hollow;
+}
+
+void TQuickShadow::setHollow(bool hollow)
+{
+    if (m_hollow == hollow)
+        return;
+
+    m_hollow = hollow;
+    update();
+    Q_EMIT hollowChanged();
+}
+
+void TQuickShadow::invalidateSceneGraph()
+{
+    // The cache deleted its textures along with the scene graph
+    m_texture = nullptr;
+}
+
+void TQuickShadow::releaseResources()
+{
+    QQuickItem::releaseResources();
+
+    if (m_texture) {
+        TShadowCache::instance()->release(window(), m_textureKey, m_texture);
+        m_texture = nullptr;
+    }
+}
+
+QSGNode *TQuickShadow::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    if (width() <= 0 || height() <= 0 || m_shadowColor.alpha() == 0) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    const qreal dpr = window()->effectiveDevicePixelRatio();
+    TShadowCache::Key key;
+    // A rounded rect can't have corners beyond half its size, clamping here
+    // also keeps small items from rendering huge corner patches
+    key.radius = qRound(qMin(m_cornerRadius, qMin(width(), height()) / 2) * dpr);
+    key.blur = qRound(m_shadowBlur * dpr);
+    key.offsetY = qRound(m_shadowOffsetY * dpr);
+    key.color = m_shadowColor.rgba();
+    key.hollow = m_hollow;
+    if (!m_texture || !oldNode || m_textureKey != key) {
+        auto cache = TShadowCache::instance();
+        QSGTexture *texture = cache->texture(window(), key);
+        if (m_texture)
+            cache->release(window(), m_textureKey, m_texture);
+        m_texture = texture;
+        m_textureKey = key;
+    }
+    QSGTexture *texture = m_texture;
+
+    const qreal blur = key.blur / dpr;
+    const QRectF rect =
+        QRectF(0, m_shadowOffsetY, width(), height()).adjusted(-blur, -blur, blur, blur);
+    const int cornerSize = TShadowCache::cornerSize(key);
+    // Small items take less of the corners
+    const qreal cornerX = qMin(cornerSize / dpr, rect.width() / 2);
+    const qreal cornerY = qMin(cornerSize / dpr, rect.height() / 2);
+    const qreal xs[] = { rect.left(), rect.left() + cornerX, rect.right() - cornerX, rect.right() };
+    const qreal ys[] = { rect.top(), rect.top() + cornerY, rect.bottom() - cornerY, rect.bottom() };
+
+    // The middle slice stretches the one pixel between the corners of the image
+    const qreal imageSize = 2 * cornerSize + 1;
+    const qreal us[] = { 0, cornerX * dpr, imageSize - cornerX * dpr, imageSize };
+    const qreal vs[] = { 0, cornerY * dpr, imageSize - cornerY * dpr, imageSize };
+
+    if (window()->rendererInterface()->graphicsApi() == QSGRendererInterface::Software) {
+        // The software backend draws no custom geometry, so each slice is an image node
+        QSGNode *node = oldNode;
+        if (!node) {
+            node = new QSGNode;
+            for (int i = 0; i < 9; ++i) {
+                auto slice = window()->createImageNode();
+                slice->setFiltering(QSGTexture::Linear);
+                node->appendChildNode(slice);
+            }
+        }
+
+        auto slice = static_cast<QSGImageNode *>(node->firstChild());
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                slice->setTexture(texture);
+                slice->setRect(QRectF(QPointF(xs[column], ys[row]),
+                                      QPointF(xs[column + 1], ys[row + 1])));
+                slice->setSourceRect(QRectF(QPointF(us[column], vs[row]),
+                                            QPointF(us[column + 1], vs[row + 1])));
+                slice = static_cast<QSGImageNode *>(slice->nextSibling());
+            }
+        }
+
+        return node;
+    }
+
+    auto node = static_cast<QSGGeometryNode *>(oldNode);
+    if (!node) {
+        node = new QSGGeometryNode;
+        // 4x4 vertices, two triangles for each of the nine slices
+        auto geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 16, 54);
+        geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+        quint16 *indices = geometry->indexDataAsUShort();
+        for (int row = 0; row < 3; ++row) {
+            for (int column = 0; column < 3; ++column) {
+                const quint16 i = row * 4 + column;
+                *indices++ = i;
+                *indices++ = i + 1;
+                *indices++ = i + 4;
+                *indices++ = i + 1;
+                *indices++ = i + 5;
+                *indices++ = i + 4;
+            }
+        }
+        node->setGeometry(geometry);
+        node->setFlag(QSGNode::OwnsGeometry);
+        node->setMaterial(new QSGTextureMaterial);
+        node->setFlag(QSGNode::OwnsMaterial);
+    }
+
+    auto material = static_cast<QSGTextureMaterial *>(node->material());
+    if (material->texture() != texture) {
+        material->setTexture(texture);
+        material->setFiltering(QSGTexture::Linear);
+        node->markDirty(QSGNode::DirtyMaterial);
+    }
+
+    const QRectF subRect = texture->normalizedTextureSubRect();
+
+    auto vertices = node->geometry()->vertexDataAsTexturedPoint2D();
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            vertices[row * 4 + column].set(xs[column],
+                                           ys[row],
+                                           subRect.x() + us[column] / imageSize * subRect.width(),
+                                           subRect.y() + vs[row] / imageSize * subRect.height());
+        }
+    }
+    node->markDirty(QSGNode::DirtyGeometry);
+
+    return node;
+}
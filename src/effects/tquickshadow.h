@@ -0,0 +1,66 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#pragma once
+
+#include "tshadowcache.h"
+
+#include <QColor>
+#include <QQuickItem>
+
+// Box shadow of a rounded rect the size of the item, drawn as nine slices of
+// a shared TShadowCache image, so resizing never renders the shadow again
+class TQuickShadow : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(qreal cornerRadius READ cornerRadius WRITE setCornerRadius NOTIFY cornerRadiusChanged FINAL)
+    Q_PROPERTY(qreal shadowBlur READ shadowBlur WRITE setShadowBlur NOTIFY shadowBlurChanged FINAL)
+    Q_PROPERTY(qreal shadowOffsetY READ shadowOffsetY WRITE setShadowOffsetY NOTIFY shadowOffsetYChanged FINAL)
+    Q_PROPERTY(QColor shadowColor READ shadowColor WRITE setShadowColor NOTIFY shadowColorChanged FINAL)
+    Q_PROPERTY(bool hollow READ hollow WRITE setHollow NOTIFY hollowChanged FINAL)
+    QML_NAMED_ELEMENT(TShadow)
+
+public:
+    explicit TQuickShadow(QQuickItem *parent = nullptr);
+
+    qreal cornerRadius() const;
+    void setCornerRadius(qreal radius);
+
+    qreal shadowBlur() const;
+    void setShadowBlur(qreal blur);
+
+    qreal shadowOffsetY() const;
+    void setShadowOffsetY(qreal offset);
+
+    QColor shadowColor() const;
+    void setShadowColor(const QColor &color);
+
+    bool hollow() const;
+    void setHollow(bool hollow);
+
+Q_SIGNALS:
+    void cornerRadiusChanged();
+    void shadowBlurChanged();
+    void shadowOffsetYChanged();
+    void shadowColorChanged();
+    void hollowChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void releaseResources() override;
+
+private Q_SLOTS:
+    // Called by the scene graph, see QQuickItem's graphics resource handling
+    void invalidateSceneGraph();
+
+private:
+    // The cache texture held by the paint node, released with it
+    QSGTexture *m_texture = nullptr;
+    TShadowCache::Key m_textureKey;
+
+    qreal m_cornerRadius = 0;
+    qreal m_shadowBlur = 0;
+    qreal m_shadowOffsetY = 0;
+    QColor m_shadowColor = Qt::black;
+    bool m_hollow = false;
+};
@@ -0,0 +1,169 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tquicksoftwareblur.h"
+
+#include "tsoftwareeffects.h"
+
+class TSoftwareBlurTextureProvider : public QSGTextureProvider
+{
+public:
+    QSGTexture *texture() const override { return const_cast<TSGSoftwareBlurTexture *>(&m_texture); }
+
+    TSGSoftwareBlurTexture m_texture;
+};
+
+void TSGSoftwareBlurTexture::setSource(QSGTextureProvider *source)
+{
+    if (source == m_source)
+        return;
+
+    m_source = source;
+    m_sourceKey = 0;
+}
+
+void TSGSoftwareBlurTexture::setRadius(int radius)
+{
+    m_radius = radius;
+}
+
+QImage TSGSoftwareBlurTexture::image() const
+{
+    return m_image;
+}
+
+qint64 TSGSoftwareBlurTexture::comparisonKey() const
+{
+    return qint64(this);
+}
+
+QSize TSGSoftwareBlurTexture::textureSize() const
+{
+    return m_image.size();
+}
+
+bool TSGSoftwareBlurTexture::hasAlphaChannel() const
+{
+    return m_image.hasAlphaChannel();
+}
+
+bool TSGSoftwareBlurTexture::hasMipmaps() const
+{
+    return false;
+}
+
+bool TSGSoftwareBlurTexture::updateTexture()
+{
+    QSGTexture *source = m_source ? m_source->texture() : nullptr;
+    if (auto dynamic = qobject_cast<QSGDynamicTexture *>(source))
+        dynamic->updateTexture();
+
+    const QImage image = TSoftwareEffects::textureImage(source);
+    if (image.isNull() || (image.cacheKey() == m_sourceKey && m_radius == m_imageRadius))
+        return false;
+
+    m_sourceKey = image.cacheKey();
+    m_imageRadius = m_radius;
+    // A wide blur looks the same from half the resolution, which leaves a
+    // quarter of the pixels and half the radius. Users sample the texture
+    // through normalized source rects, so its size doesn't matter to them.
+    if (m_radius >= DownscaleRadius && image.width() >= 2 && image.height() >= 2) {
+        m_image = TSoftwareEffects::scaled(image, image.size() / 2);
+        TSoftwareEffects::boxBlur(m_image, m_radius / 2);
+    } else {
+        m_image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+        TSoftwareEffects::boxBlur(m_image, m_radius);
+    }
+    return true;
+}
+
+TQuickSoftwareBlur::TQuickSoftwareBlur(QQuickItem *parent)
+    : QQuickItem(parent)
+{
+    setFlag(ItemHasContents);
+}
+
+TQuickSoftwareBlur::~TQuickSoftwareBlur()
+{
+    // Software textures hold no graphics resources, any thread may delete them
+    if (m_provider)
+        m_provider->deleteLater();
+}
+
+QQuickItem *TQuickSoftwareBlur::sourceItem() const
+{
+    return m_sourceItem;
+}
+
+void TQuickSoftwareBlur::setSourceItem(QQuickItem *item)
+{
+    if (item == m_sourceItem)
+        return;
+
+    m_sourceItem = item;
+    update();
+    Q_EMIT sourceItemChanged();
+}
+
+int TQuickSoftwareBlur::radius() const
+{
+    return m_radius;
+}
+
+void TQuickSoftwareBlur::setRadius(int radius)
+{
+    if (radius == m_radius)
+        return;
+
+    m_radius = radius;
+    update();
+    Q_EMIT radiusChanged();
+}
+
+bool TQuickSoftwareBlur::isTextureProvider() const
+{
+    return true;
+}
+
+QSGTextureProvider *TQuickSoftwareBlur::textureProvider() const
+{
+    if (!m_provider)
+        m_provider = new TSoftwareBlurTextureProvider;
+    return m_provider;
+}
+
+QSGNode *TQuickSoftwareBlur::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *)
+{
+    delete oldNode;
+
+    auto provider = static_cast<TSoftwareBlurTextureProvider *>(textureProvider());
+    QSGTextureProvider *source =
+        m_sourceItem && m_sourceItem->isTextureProvider() ? m_sourceItem->textureProvider() : nullptr;
+    provider->m_texture.setSource(source);
+    provider->m_texture.setRadius(m_radius);
+
+    // Users of the blur repaint whenever the source does
+    if (source != m_connectedSource) {
+        QObject::disconnect(m_sourceConnection);
+        m_connectedSource = source;
+        if (source) {
+            m_sourceConnection = connect(source,
+                                         &QSGTextureProvider::textureChanged,
+                                         provider,
+                                         &QSGTextureProvider::textureChanged,
+                                         Qt::DirectConnection);
+        }
+    }
+    Q_EMIT provider->textureChanged();
+
+    return nullptr;
+}
+
+void TQuickSoftwareBlur::releaseResources()
+{
+    if (m_provider) {
+        m_provider->deleteLater();
+        m_provider = nullptr;
+        m_connectedSource = nullptr;
+    }
+}
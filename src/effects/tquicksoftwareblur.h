@@ -0,0 +1,83 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#pragma once
+
+#include <QImage>
+#include <QPointer>
+#include <QQuickItem>
+#include <QSGDynamicTexture>
+#include <QSGTextureProvider>
+
+class TSoftwareBlurTextureProvider;
+
+// Box blurred copy of another software texture. Like a layer it only does the
+// work when a node using it calls updateTexture(), and only if the source changed.
+class TSGSoftwareBlurTexture : public QSGDynamicTexture
+{
+    Q_OBJECT
+
+public:
+    void setSource(QSGTextureProvider *source);
+    void setRadius(int radius);
+
+    QImage image() const;
+
+    qint64 comparisonKey() const override;
+    QSize textureSize() const override;
+    bool hasAlphaChannel() const override;
+    bool hasMipmaps() const override;
+    bool updateTexture() override;
+
+private:
+    // From this radius on the image is blurred at half its size
+    static constexpr int DownscaleRadius = 4;
+
+    QPointer<QSGTextureProvider> m_source;
+    int m_radius = 0;
+
+    QImage m_image;
+    qint64 m_sourceKey = 0;
+    int m_imageRadius = -1;
+};
+
+// Blurs sourceItem, a texture provider, on the CPU for the software scene graph
+// backend where ShaderEffect is unavailable. Meant to be used as a texture
+// provider, the item itself draws nothing.
+class TQuickSoftwareBlur : public QQuickItem
+{
+    Q_OBJECT
+    Q_PROPERTY(QQuickItem *sourceItem READ sourceItem WRITE setSourceItem NOTIFY sourceItemChanged FINAL)
+    // In pixels of the source texture, three passes reach about 3 * radius
+    Q_PROPERTY(int radius READ radius WRITE setRadius NOTIFY radiusChanged FINAL)
+    QML_NAMED_ELEMENT(TSoftwareBlur)
+
+public:
+    explicit TQuickSoftwareBlur(QQuickItem *parent = nullptr);
+    ~TQuickSoftwareBlur() override;
+
+    QQuickItem *sourceItem() const;
+    void setSourceItem(QQuickItem *item);
+
+    int radius() const;
+    void setRadius(int radius);
+
+    bool isTextureProvider() const override;
+    QSGTextureProvider *textureProvider() const override;
+
+Q_SIGNALS:
+    void sourceItemChanged();
+    void radiusChanged();
+
+protected:
+    QSGNode *updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) override;
+    void releaseResources() override;
+
+private:
+    QPointer<QQuickItem> m_sourceItem;
+    int m_radius = 4;
+
+    mutable TSoftwareBlurTextureProvider *m_provider = nullptr;
+    QPointer<QSGTextureProvider> m_connectedSource;
+    QMetaObject::Connection m_sourceConnection;
+};
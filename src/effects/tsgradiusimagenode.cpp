@@ -150,8 +150,111 @@ QSGMaterialShader *TSGRadiusSmoothTextureMaterial::createShader(
     return new TSmoothTextureMaterialRhiShader();
 }
 
+class TSdfTextureMaterialRhiShader : public QSGOpaqueTextureMaterialRhiShader
+{
+public:
+    TSdfTextureMaterialRhiShader();
+
+    bool updateUniformData(RenderState &state,
+                           QSGMaterial *newMaterial,
+                           QSGMaterial *oldMaterial) override;
+};
+
+TSdfTextureMaterialRhiShader::TSdfTextureMaterialRhiShader()
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+    : QSGOpaqueTextureMaterialRhiShader(1) // TODO: support multiview
+#endif
+{
+    setShaderFileName(VertexStage, QStringLiteral(":/shaders/radiussdftexture.vert.qsb"));
+    setShaderFileName(FragmentStage, QStringLiteral(":/shaders/radiussdftexture.frag.qsb"));
+}
+
+bool TSdfTextureMaterialRhiShader::updateUniformData(RenderState &state,
+                                                     QSGMaterial *newMaterial,
+                                                     QSGMaterial *oldMaterial)
+{
+    QByteArray *buf = state.uniformData();
+    Q_ASSERT(buf->size() >= 128);
+
+    if (state.isOpacityDirty()) {
+        const float opacity = state.opacity();
+        memcpy(buf->data() + 64, &opacity, 4);
+    }
+
+    // Batching is disabled for this material, so every node has its own buffer
+    const auto &uniforms = static_cast<TSGRadiusSdfTextureMaterial *>(newMaterial)->uniforms();
+    const float data[] = {
+        uniforms.antialiasingWidth,
+        0,
+        0,
+        float(uniforms.rect.x()),
+        float(uniforms.rect.y()),
+        float(uniforms.rect.width()),
+        float(uniforms.rect.height()),
+        float(uniforms.sourceRect.x()),
+        float(uniforms.sourceRect.y()),
+        float(uniforms.sourceRect.width()),
+        float(uniforms.sourceRect.height()),
+        uniforms.radius.x(),
+        uniforms.radius.y(),
+        uniforms.radius.z(),
+        uniforms.radius.w(),
+    };
+    memcpy(buf->data() + 68, data, sizeof(data));
+
+    QSGOpaqueTextureMaterialRhiShader::updateUniformData(state, newMaterial, oldMaterial);
+    return true;
+}
+
+TSGRadiusSdfTextureMaterial::TSGRadiusSdfTextureMaterial()
+{
+    setFlag(QSGTextureMaterial::Blending);
+    // rect and the radii are uniforms of each node. A merged batch would move
+    // the vertices into the space of the batch root, away from rect. Nodes
+    // sample their own texture anyway, so they would not share a draw call.
+#if QT_VERSION >= QT_VERSION_CHECK(6, 3, 0)
+    setFlag(QSGMaterial::NoBatching);
+#else
+    setFlag(QSGMaterial::CustomCompileStep);
+#endif
+}
+
+int TSGRadiusSdfTextureMaterial::compare(const QSGMaterial *other) const
+{
+    Q_ASSERT(other && type() == other->type());
+    const qintptr diff = qintptr(this) - qintptr(other);
+    return diff < 0 ? -1 : (diff > 0 ? 1 : 0);
+}
+
+const TSGRadiusSdfTextureMaterial::Uniforms &TSGRadiusSdfTextureMaterial::uniforms() const
+{
+    return m_uniforms;
+}
+
+void TSGRadiusSdfTextureMaterial::setUniforms(const Uniforms &uniforms)
+{
+    m_uniforms = uniforms;
+}
+
+QSGMaterialType *TSGRadiusSdfTextureMaterial::type() const
+{
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader *TSGRadiusSdfTextureMaterial::createShader(
+    QSGRendererInterface::RenderMode renderMode) const
+{
+    Q_UNUSED(renderMode);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+    Q_ASSERT_X(viewCount() == 1, __func__, "Multiview not supported now.");
+#endif
+    return new TSdfTextureMaterialRhiShader();
+}
+
 TSGRadiusImageNode::TSGRadiusImageNode()
-    : m_antialiasing(false)
+    : m_clipMode(defaultClipMode())
+    , m_antialiasing(false)
     , m_dirtyGeometry(false)
 {
     setFlag(QSGNode::UsePreprocess);
@@ -167,6 +270,30 @@ TSGRadiusImageNode::TSGRadiusImageNode()
 #endif
 }
 
+TSGRadiusImageNode::ClipMode TSGRadiusImageNode::defaultClipMode()
+{
+    static const ClipMode mode = qEnvironmentVariableIsSet("TREELAND_RADIUS_GEOMETRY")
+        ? ClipMode::Geometry
+        : ClipMode::Shader;
+    return mode;
+}
+
+TSGRadiusImageNode::ClipMode TSGRadiusImageNode::clipMode() const
+{
+    return m_clipMode;
+}
+
+void TSGRadiusImageNode::setClipMode(ClipMode mode)
+{
+    if (m_clipMode == mode)
+        return;
+
+    m_clipMode = mode;
+    resetGeometry();
+    updateMaterialAntialiasing();
+    m_dirtyGeometry = true;
+}
+
 void TSGRadiusImageNode::setRect(const QRectF &rect)
 {
     if (rect == m_targetRect)
@@ -176,6 +303,15 @@ void TSGRadiusImageNode::setRect(const QRectF &rect)
     m_dirtyGeometry = true;
 }
 
+void TSGRadiusImageNode::setSourceRect(const QRectF &rect)
+{
+    if (rect == m_sourceRect)
+        return;
+
+    m_sourceRect = rect;
+    m_dirtyGeometry = true;
+}
+
 void TSGRadiusImageNode::setTexture(QSGTexture *texture)
 {
     Q_ASSERT(texture);
@@ -184,6 +320,7 @@ void TSGRadiusImageNode::setTexture(QSGTexture *texture)
         m_material.setTexture(texture);
         m_opaquematerial.setTexture(texture);
         m_radiusMaterial.setTexture(texture);
+        m_sdfMaterial.setTexture(texture);
 
         setMipmapFiltering(texture->mipmapFiltering());
         setFiltering(texture->filtering());
@@ -246,6 +383,7 @@ void TSGRadiusImageNode::setFiltering(QSGTexture::Filtering filtering)
     m_material.setFiltering(filtering);
     m_opaquematerial.setFiltering(filtering);
     m_radiusMaterial.setFiltering(filtering);
+    m_sdfMaterial.setFiltering(filtering);
     markDirty(DirtyMaterial);
 }
 
@@ -257,6 +395,7 @@ void TSGRadiusImageNode::setMipmapFiltering(QSGTexture::Filtering filtering)
     m_material.setMipmapFiltering(filtering);
     m_opaquematerial.setMipmapFiltering(filtering);
     m_radiusMaterial.setMipmapFiltering(filtering);
+    m_sdfMaterial.setMipmapFiltering(filtering);
     markDirty(DirtyMaterial);
 }
 
@@ -268,6 +407,7 @@ void TSGRadiusImageNode::setVerticalWrapMode(QSGTexture::WrapMode wrapMode)
     m_material.setVerticalWrapMode(wrapMode);
     m_opaquematerial.setVerticalWrapMode(wrapMode);
     m_radiusMaterial.setVerticalWrapMode(wrapMode);
+    m_sdfMaterial.setVerticalWrapMode(wrapMode);
     markDirty(DirtyMaterial);
 }
 
@@ -279,6 +419,7 @@ void TSGRadiusImageNode::setHorizontalWrapMode(QSGTexture::WrapMode wrapMode)
     m_material.setHorizontalWrapMode(wrapMode);
     m_opaquematerial.setHorizontalWrapMode(wrapMode);
     m_radiusMaterial.setHorizontalWrapMode(wrapMode);
+    m_sdfMaterial.setHorizontalWrapMode(wrapMode);
     markDirty(DirtyMaterial);
 }
 
@@ -328,16 +469,34 @@ void TSGRadiusImageNode::setAntialiasing(bool antialiasing)
         return;
 
     m_antialiasing = antialiasing;
-    if (m_radius > 0 || m_topLeftRadius > 0 || m_topRightRadius > 0 || m_bottomLeftRadius > 0
-        || m_bottomRightRadius > 0) {
+    resetGeometry();
+    updateMaterialAntialiasing();
+    m_dirtyGeometry = true;
+}
+
+bool TSGRadiusImageNode::hasRadius() const
+{
+    return m_radius > 0 || m_topLeftRadius > 0 || m_topRightRadius > 0 || m_bottomLeftRadius > 0
+        || m_bottomRightRadius > 0;
+}
+
+bool TSGRadiusImageNode::useShaderClip() const
+{
+    return m_clipMode == ClipMode::Shader && hasRadius();
+}
+
+void TSGRadiusImageNode::resetGeometry()
+{
+    if (useShaderClip()) {
+        auto g = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 4);
+        g->setDrawingMode(QSGGeometry::DrawTriangleStrip);
+        m_node.setGeometry(g);
+    } else if (hasRadius()) {
         m_node.setGeometry(new QSGGeometry(radiusImageAttributeSet(), 0));
     } else {
         m_node.setGeometry(new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 4));
     }
     m_node.setFlag(OwnsGeometry);
-
-    updateMaterialAntialiasing();
-    m_dirtyGeometry = true;
 }
 
 void TSGRadiusImageNode::setTextureProvider(QSGTextureProvider *p)
@@ -364,10 +523,17 @@ void TSGRadiusImageNode::handleTextureChange()
     markDirty(QSGNode::DirtyMaterial);
 }
 
+const QSGGeometryNode *TSGRadiusImageNode::geometryNode() const
+{
+    return &m_node;
+}
+
 void TSGRadiusImageNode::updateMaterialAntialiasing()
 {
-    if (m_radius > 0 || m_topLeftRadius > 0 || m_topRightRadius > 0 || m_bottomLeftRadius > 0
-        || m_bottomRightRadius > 0) {
+    if (useShaderClip()) {
+        m_node.setMaterial(&m_sdfMaterial);
+        m_node.setOpaqueMaterial(nullptr);
+    } else if (hasRadius()) {
         m_node.setMaterial(&m_radiusMaterial);
         m_node.setOpaqueMaterial(nullptr);
     } else {
@@ -381,6 +547,7 @@ void TSGRadiusImageNode::setMaterialTexture(QSGTexture *texture)
     m_material.setTexture(texture);
     m_opaquematerial.setTexture(texture);
     m_radiusMaterial.setTexture(texture);
+    m_sdfMaterial.setTexture(texture);
 }
 
 bool TSGRadiusImageNode::updateMaterialBlending()
@@ -390,6 +557,9 @@ bool TSGRadiusImageNode::updateMaterialBlending()
     if (m_radiusMaterial.texture()) {
         m_radiusMaterial.setFlag(QSGMaterial::Blending, true);
     }
+    if (m_sdfMaterial.texture()) {
+        m_sdfMaterial.setFlag(QSGMaterial::Blending, true);
+    }
 
     if (texture() && alpha != texture()->hasAlphaChannel()) {
         m_opaquematerial.setFlag(QSGMaterial::Blending, !alpha);
@@ -401,12 +571,42 @@ bool TSGRadiusImageNode::updateMaterialBlending()
 
 void TSGRadiusImageNode::updateGeometry()
 {
-    QRectF textRect = QRectF(0, 0, 1, 1);
-    if (m_radius > 0 || m_topLeftRadius > 0 || m_topRightRadius > 0 || m_bottomLeftRadius > 0
-        || m_bottomRightRadius > 0) {
-        updateTexturedRadiusGeometry(m_targetRect, textRect);
+    // The radius may have been set after the antialiasing
+    if ((m_node.material() == &m_sdfMaterial) != useShaderClip()) {
+        resetGeometry();
+        updateMaterialAntialiasing();
+    }
+
+    if (useShaderClip()) {
+        const float maxRadius = qMin(m_targetRect.width(), m_targetRect.height()) * 0.4999f;
+        auto cornerRadius = [this, maxRadius](float radius) {
+            return qMin(maxRadius, radius < 0 ? m_radius : radius);
+        };
+
+        TSGRadiusSdfTextureMaterial::Uniforms uniforms;
+        uniforms.rect = m_targetRect;
+        uniforms.sourceRect = m_sourceRect;
+        uniforms.radius = QVector4D(cornerRadius(m_topLeftRadius),
+                                    cornerRadius(m_topRightRadius),
+                                    cornerRadius(m_bottomRightRadius),
+                                    cornerRadius(m_bottomLeftRadius));
+        uniforms.antialiasingWidth = m_antialiasing ? m_antialiasingWidth : 0;
+        m_sdfMaterial.setUniforms(uniforms);
+
+        // The renderer takes the bounds of the node from its vertices
+        auto v = m_node.geometry()->vertexDataAsPoint2D();
+        v[0].set(m_targetRect.left(), m_targetRect.top());
+        v[1].set(m_targetRect.left(), m_targetRect.bottom());
+        v[2].set(m_targetRect.right(), m_targetRect.top());
+        v[3].set(m_targetRect.right(), m_targetRect.bottom());
+        m_node.markDirty(QSGNode::DirtyMaterial | QSGNode::DirtyGeometry);
+        return;
+    }
+
+    if (hasRadius()) {
+        updateTexturedRadiusGeometry(m_targetRect, m_sourceRect);
     } else {
-        QSGGeometry::updateTexturedRectGeometry(m_node.geometry(), m_targetRect, textRect);
+        QSGGeometry::updateTexturedRectGeometry(m_node.geometry(), m_targetRect, m_sourceRect);
     }
     m_node.markDirty(QSGNode::DirtyGeometry);
 }
@@ -732,6 +932,15 @@ void TSGRadiusImageNode::updateTexturedRadiusGeometry(const QRectF &rect, const
 
     Q_ASSERT(index == vertexCount);
 
+    if (textureRect != QRectF(0, 0, 1, 1)) {
+        char *data = static_cast<char *>(g->vertexData());
+        for (int i = 0; i < vertexCount; ++i) {
+            auto v = reinterpret_cast<ImageVertex *>(data + i * vertexStride);
+            v->tx = textureRect.x() + v->tx * textureRect.width();
+            v->ty = textureRect.y() + v->ty * textureRect.height();
+        }
+    }
+
     if (m_antialiasing) {
         indices[--innerAAHead] = indices[innerAATail - 1];
         indices[--innerAAHead] = indices[innerAATail - 2];
@@ -7,6 +7,7 @@
 #include <QSGGeometryNode>
 #include <QSGTextureMaterial>
 #include <QSGTextureProvider>
+#include <QVector4D>
 
 class TSGRadiusSmoothTextureMaterial : public QSGOpaqueTextureMaterial
 {
@@ -19,15 +20,57 @@ protected:
     QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
 };
 
+// Clips with a signed distance function on a single quad, so resizing only
+// changes the uniforms and four vertices
+class TSGRadiusSdfTextureMaterial : public QSGOpaqueTextureMaterial
+{
+public:
+    struct Uniforms
+    {
+        QRectF rect;
+        QRectF sourceRect = QRectF(0, 0, 1, 1);
+        // top left, top right, bottom right, bottom left
+        QVector4D radius;
+        float antialiasingWidth = 0;
+    };
+
+    TSGRadiusSdfTextureMaterial();
+    int compare(const QSGMaterial *other) const override;
+
+    const Uniforms &uniforms() const;
+    void setUniforms(const Uniforms &uniforms);
+
+protected:
+    QSGMaterialType *type() const override;
+    QSGMaterialShader *createShader(QSGRendererInterface::RenderMode renderMode) const override;
+
+private:
+    Uniforms m_uniforms;
+};
+
 class TSGRadiusImageNode
     : public QObject
     , public QSGNode
 {
     Q_OBJECT
 public:
+    enum class ClipMode {
+        // Single quad, corners cut in the fragment shader
+        Shader,
+        // Triangle strip following the corners, rebuilt on every resize
+        Geometry,
+    };
+
     TSGRadiusImageNode();
 
+    // Shader unless TREELAND_RADIUS_GEOMETRY is set
+    static ClipMode defaultClipMode();
+    ClipMode clipMode() const;
+    void setClipMode(ClipMode mode);
+
     void setRect(const QRectF &rect);
+    // Normalized part of the texture that is drawn
+    void setSourceRect(const QRectF &rect);
     void setAntialiasingWidth(float width);
 
     void preprocess() override;
@@ -49,6 +92,7 @@ public slots:
     void handleTextureChange();
 
 protected:
+    const QSGGeometryNode *geometryNode() const;
     void updateMaterialAntialiasing();
     void setMaterialTexture(QSGTexture *texture);
     bool updateMaterialBlending();
@@ -56,6 +100,9 @@ protected:
     void updateTexturedRadiusGeometry(const QRectF &rect, const QRectF &textureRect);
 
 private:
+    bool hasRadius() const;
+    bool useShaderClip() const;
+    void resetGeometry();
     void setTexture(QSGTexture *texture);
     QSGTexture *texture() const;
 
@@ -65,10 +112,12 @@ private:
     QSGOpaqueTextureMaterial m_opaquematerial;
     QSGTextureMaterial m_material;
     TSGRadiusSmoothTextureMaterial m_radiusMaterial;
+    TSGRadiusSdfTextureMaterial m_sdfMaterial;
 
     QPointer<QSGTextureProvider> m_provider;
 
     QRectF m_targetRect;
+    QRectF m_sourceRect = QRectF(0, 0, 1, 1);
     QSize m_textureSize;
 
     float m_radius = 0.0f;
@@ -77,6 +126,7 @@ private:
     float m_bottomLeftRadius = -1.0f;
     float m_bottomRightRadius = -1.0f;
     float m_antialiasingWidth = 1;
+    ClipMode m_clipMode;
 
     uint m_antialiasing : 1;
     uint m_dirtyGeometry : 1;
@@ -0,0 +1,195 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tsgsoftwareradiusnode.h"
+
+#include "tsoftwareeffects.h"
+
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGRendererInterface>
+
+TSGSoftwareRadiusNode::TSGSoftwareRadiusNode(QQuickWindow *window)
+    : m_window(window)
+{
+    setFlag(UsePreprocess);
+}
+
+void TSGSoftwareRadiusNode::setRect(const QRectF &rect)
+{
+    if (rect == m_rect)
+        return;
+
+    m_rect = rect;
+    m_dirty = true;
+    markDirty(DirtyMaterial);
+}
+
+void TSGSoftwareRadiusNode::setSourceRect(const QRectF &rect)
+{
+    if (rect == m_sourceRect)
+        return;
+
+    m_sourceRect = rect;
+    m_dirty = true;
+    markDirty(DirtyMaterial);
+}
+
+void TSGSoftwareRadiusNode::setRadius(qreal radius)
+{
+    if (radius != m_radius) {
+        m_radius = radius;
+        m_dirty = true;
+    }
+}
+
+void TSGSoftwareRadiusNode::setTopLeftRadius(qreal radius)
+{
+    if (radius != m_topLeftRadius) {
+        m_topLeftRadius = radius;
+        m_dirty = true;
+    }
+}
+
+void TSGSoftwareRadiusNode::setTopRightRadius(qreal radius)
+{
+    if (radius != m_topRightRadius) {
+        m_topRightRadius = radius;
+        m_dirty = true;
+    }
+}
+
+void TSGSoftwareRadiusNode::setBottomLeftRadius(qreal radius)
+{
+    if (radius != m_bottomLeftRadius) {
+        m_bottomLeftRadius = radius;
+        m_dirty = true;
+    }
+}
+
+void TSGSoftwareRadiusNode::setBottomRightRadius(qreal radius)
+{
+    if (radius != m_bottomRightRadius) {
+        m_bottomRightRadius = radius;
+        m_dirty = true;
+    }
+}
+
+void TSGSoftwareRadiusNode::setTextureProvider(QSGTextureProvider *provider)
+{
+    if (provider == m_provider)
+        return;
+
+    if (m_provider) {
+        disconnect(m_provider.data(),
+                   &QSGTextureProvider::textureChanged,
+                   this,
+                   &TSGSoftwareRadiusNode::handleTextureChange);
+    }
+
+    m_provider = provider;
+    connect(m_provider.data(),
+            &QSGTextureProvider::textureChanged,
+            this,
+            &TSGSoftwareRadiusNode::handleTextureChange,
+            Qt::DirectConnection);
+    m_dirty = true;
+}
+
+void TSGSoftwareRadiusNode::handleTextureChange()
+{
+    markDirty(DirtyMaterial);
+}
+
+void TSGSoftwareRadiusNode::preprocess()
+{
+    // Layers render their content here, before anything is painted
+    if (auto texture = qobject_cast<QSGDynamicTexture *>(m_provider ? m_provider->texture() : nullptr))
+        texture->updateTexture();
+}
+
+void TSGSoftwareRadiusNode::render(const RenderState *state)
+{
+    const QImage image = TSoftwareEffects::textureImage(m_provider ? m_provider->texture() : nullptr);
+    if (image.isNull() || m_rect.isEmpty())
+        return;
+
+    auto painter = static_cast<QPainter *>(
+        m_window->rendererInterface()->getResource(m_window,
+                                                   QSGRendererInterface::PainterResource));
+    if (!painter)
+        return;
+
+    // The clip region is in window coordinates, so it goes before the transform
+    const QRegion *clipRegion = state->clipRegion();
+    if (clipRegion && !clipRegion->isEmpty())
+        painter->setClipRegion(*clipRegion, Qt::ReplaceClip);
+    painter->setTransform(matrix()->toTransform());
+    painter->setOpacity(inheritedOpacity());
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+
+    updateClippedImage(image);
+    if (m_clipped.isNull())
+        painter->drawImage(m_rect, image, sourcePixels(image));
+    else
+        painter->drawImage(m_rect, m_clipped);
+}
+
+QSGRenderNode::StateFlags TSGSoftwareRadiusNode::changedStates() const
+{
+    return {};
+}
+
+QSGRenderNode::RenderingFlags TSGSoftwareRadiusNode::flags() const
+{
+    return BoundedRectRendering;
+}
+
+QRectF TSGSoftwareRadiusNode::rect() const
+{
+    return m_rect;
+}
+
+qreal TSGSoftwareRadiusNode::cornerRadius(qreal radius) const
+{
+    return radius < 0 ? m_radius : radius;
+}
+
+QRect TSGSoftwareRadiusNode::sourcePixels(const QImage &image) const
+{
+    return QRectF(m_sourceRect.x() * image.width(),
+                  m_sourceRect.y() * image.height(),
+                  m_sourceRect.width() * image.width(),
+                  m_sourceRect.height() * image.height())
+        .toAlignedRect()
+        .intersected(image.rect());
+}
+
+void TSGSoftwareRadiusNode::updateClippedImage(const QImage &image)
+{
+    if (!m_dirty && image.cacheKey() == m_clippedKey)
+        return;
+
+    m_dirty = false;
+    m_clippedKey = image.cacheKey();
+
+    const qreal topLeft = cornerRadius(m_topLeftRadius);
+    const qreal topRight = cornerRadius(m_topRightRadius);
+    const qreal bottomRight = cornerRadius(m_bottomRightRadius);
+    const qreal bottomLeft = cornerRadius(m_bottomLeftRadius);
+    if (topLeft <= 0 && topRight <= 0 && bottomRight <= 0 && bottomLeft <= 0) {
+        // Without corners the texture is drawn as is
+        m_clipped = {};
+        return;
+    }
+
+    // Only the drawn part is copied, the corners are cut in its pixels
+    const QRect source = sourcePixels(image);
+    const qreal scale = qMin(source.width() / m_rect.width(), source.height() / m_rect.height());
+    m_clipped = image.copy(source);
+    TSoftwareEffects::clipCorners(m_clipped,
+                                  qRound(topLeft * scale),
+                                  qRound(topRight * scale),
+                                  qRound(bottomRight * scale),
+                                  qRound(bottomLeft * scale));
+}
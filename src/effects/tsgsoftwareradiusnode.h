@@ -0,0 +1,68 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#pragma once
+
+#include <QImage>
+#include <QPointer>
+#include <QSGRenderNode>
+#include <QSGTextureProvider>
+
+QT_BEGIN_NAMESPACE
+class QQuickWindow;
+QT_END_NAMESPACE
+
+// TSGRadiusImageNode for the software scene graph backend. The corners are cut
+// out of a copy of the texture with pixman, the copy is kept until the texture
+// or the radius changes.
+class TSGSoftwareRadiusNode
+    : public QObject
+    , public QSGRenderNode
+{
+    Q_OBJECT
+public:
+    explicit TSGSoftwareRadiusNode(QQuickWindow *window);
+
+    void setRect(const QRectF &rect);
+    // Normalized part of the texture that is drawn
+    void setSourceRect(const QRectF &rect);
+
+    // Negative corner radii fall back to radius
+    void setRadius(qreal radius);
+    void setTopLeftRadius(qreal radius);
+    void setTopRightRadius(qreal radius);
+    void setBottomLeftRadius(qreal radius);
+    void setBottomRightRadius(qreal radius);
+
+    void setTextureProvider(QSGTextureProvider *provider);
+
+    void preprocess() override;
+    void render(const RenderState *state) override;
+    StateFlags changedStates() const override;
+    RenderingFlags flags() const override;
+    QRectF rect() const override;
+
+public Q_SLOTS:
+    void handleTextureChange();
+
+private:
+    qreal cornerRadius(qreal radius) const;
+    QRect sourcePixels(const QImage &image) const;
+    void updateClippedImage(const QImage &image);
+
+    QQuickWindow *m_window;
+    QPointer<QSGTextureProvider> m_provider;
+
+    QRectF m_rect;
+    QRectF m_sourceRect = QRectF(0, 0, 1, 1);
+
+    qreal m_radius = 0;
+    qreal m_topLeftRadius = -1;
+    qreal m_topRightRadius = -1;
+    qreal m_bottomLeftRadius = -1;
+    qreal m_bottomRightRadius = -1;
+
+    QImage m_clipped;
+    qint64 m_clippedKey = 0;
+    bool m_dirty = true;
+};
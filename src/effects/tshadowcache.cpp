@@ -0,0 +1,196 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tshadowcache.h"
+
+#include <QCoreApplication>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGTexture>
+#include <QVarLengthArray>
+
+namespace {
+// One pass of a box blur along the rows or the columns of an Alpha8 image,
+// pixels outside of the image count as transparent
+void boxBlur(QImage &image, int radius, bool horizontal)
+{
+    const int length = horizontal ? image.width() : image.height();
+    const int lines = horizontal ? image.height() : image.width();
+    const int window = 2 * radius + 1;
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    uchar *bits = image.bits();
+    QVarLengthArray<uchar, 256> line(length);
+
+    for (int l = 0; l < lines; ++l) {
+        auto pixel = [&](int i) -> uchar & {
+            return horizontal ? bits[l * bytesPerLine + i] : bits[i * bytesPerLine + l];
+        };
+
+        for (int i = 0; i < length; ++i)
+            line[i] = pixel(i);
+
+        int sum = 0;
+        for (int i = 0; i < radius && i < length; ++i)
+            sum += line[i];
+
+        for (int i = 0; i < length; ++i) {
+            if (i + radius < length)
+                sum += line[i + radius];
+            if (i - radius - 1 >= 0)
+                sum -= line[i - radius - 1];
+            pixel(i) = sum / window;
+        }
+    }
+}
+} // namespace
+
+TShadowCache::TShadowCache(QObject *parent)
+    : QObject(parent)
+{
+}
+
+TShadowCache *TShadowCache::instance()
+{
+    static auto cache = new TShadowCache(QCoreApplication::instance());
+    return cache;
+}
+
+int TShadowCache::cornerSize(const Key &key)
+{
+    // Counted from the outer end of the blur, past blur + radius from the corner
+    // both the shadow and the hole no longer change along the edge
+    return 2 * key.blur + key.radius + qAbs(key.offsetY) + 1;
+}
+
+QImage TShadowCache::render(const Key &key)
+{
+    const int size = 2 * cornerSize(key) + 1;
+    const QRectF caster(key.blur, key.blur, size - 2 * key.blur, size - 2 * key.blur);
+
+    QImage mask(size, size, QImage::Format_Alpha8);
+    mask.fill(0);
+    {
+        QPainter painter(&mask);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.drawRoundedRect(caster, key.radius, key.radius);
+    }
+
+    // Three box blurs come close to a gaussian reaching blur pixels out
+    if (key.blur > 0) {
+        const int boxRadius = qMax(1, qRound(key.blur / 3.0));
+        for (int i = 0; i < 3; ++i) {
+            boxBlur(mask, boxRadius, true);
+            boxBlur(mask, boxRadius, false);
+        }
+    }
+
+    QImage image(size, size, QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < size; ++y) {
+        const uchar *alpha = mask.constScanLine(y);
+        auto line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < size; ++x) {
+            line[x] = qPremultiply(qRgba(qRed(key.color),
+                                         qGreen(key.color),
+                                         qBlue(key.color),
+                                         qAlpha(key.color) * alpha[x] / 255));
+        }
+    }
+
+    if (key.hollow) {
+        QPainter painter(&image);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setCompositionMode(QPainter::CompositionMode_Clear);
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(Qt::black);
+        painter.drawRoundedRect(caster.translated(0, -key.offsetY), key.radius, key.radius);
+    }
+
+    return image;
+}
+
+QSGTexture *TShadowCache::texture(QQuickWindow *window, const Key &key)
+{
+    auto it = m_textures.find(window);
+    if (it == m_textures.end()) {
+        it = m_textures.insert(window, {});
+        connect(
+            window,
+            &QQuickWindow::sceneGraphInvalidated,
+            this,
+            [this, window] {
+                releaseTextures(window);
+            },
+            Qt::DirectConnection);
+        connect(window, &QObject::destroyed, this, [this, window] {
+            for (const auto &entry : m_textures.take(window))
+                delete entry.texture;
+        });
+    }
+
+    auto entry = it->find(key);
+    if (entry == it->end()) {
+        Entry newEntry;
+        newEntry.texture =
+            window->createTextureFromImage(render(key), QQuickWindow::TextureCanUseAtlas);
+        newEntry.texture->setFiltering(QSGTexture::Linear);
+        entry = it->insert(key, newEntry);
+    }
+    ++entry->refs;
+    QSGTexture *texture = entry->texture;
+
+    // Nodes of removed items are gone by the time items are synchronized,
+    // so nothing still draws with an unused texture here
+    evictUnused(*it);
+    return texture;
+}
+
+void TShadowCache::release(QQuickWindow *window, const Key &key, QSGTexture *texture)
+{
+    auto it = m_textures.find(window);
+    if (it == m_textures.end())
+        return;
+
+    auto entry = it->find(key);
+    if (entry == it->end() || entry->texture != texture || entry->refs <= 0)
+        return;
+
+    if (--entry->refs == 0)
+        entry->releasedAt = ++m_releaseCount;
+}
+
+void TShadowCache::releaseTextures(QQuickWindow *window)
+{
+    auto it = m_textures.find(window);
+    if (it == m_textures.end())
+        return;
+
+    for (const auto &entry : std::as_const(*it))
+        delete entry.texture;
+    it->clear();
+}
+
+void TShadowCache::evictUnused(QHash<Key, Entry> &entries)
+{
+    int unused = 0;
+    for (const auto &entry : std::as_const(entries)) {
+        if (entry.refs == 0)
+            ++unused;
+    }
+
+    for (; unused > MaxUnusedTextures; --unused) {
+        auto oldest = entries.end();
+        for (auto entry = entries.begin(); entry != entries.end(); ++entry) {
+            if (entry->refs == 0 && (oldest == entries.end() || entry->releasedAt < oldest->releasedAt))
+                oldest = entry;
+        }
+        delete oldest->texture;
+        entries.erase(oldest);
+    }
+}
+
+size_t qHash(const TShadowCache::Key &key, size_t seed)
+{
+    return qHashMulti(seed, key.radius, key.blur, key.offsetY, key.color, key.hollow);
+}
@@ -0,0 +1,71 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#pragma once
+
+#include <QHash>
+#include <QImage>
+#include <QObject>
+#include <QRgb>
+
+QT_BEGIN_NAMESPACE
+class QQuickWindow;
+class QSGTexture;
+QT_END_NAMESPACE
+
+// Renders one nine-patch shadow image per look and shares its texture between
+// all TQuickShadow items of a window. The textures may be placed in the scene
+// graph atlas, so several looks end up in one texture. Textures no item uses
+// any more are kept for a while, at most MaxUnusedTextures per window.
+class TShadowCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Lengths are in device pixels
+    struct Key
+    {
+        int radius = 0;
+        int blur = 0;
+        int offsetY = 0;
+        QRgb color = 0;
+        bool hollow = false;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    static TShadowCache *instance();
+
+    // Size of the corner patches, the image is 2 * cornerSize + 1 pixels wide and high
+    static int cornerSize(const Key &key);
+    static QImage render(const Key &key);
+
+    static constexpr int MaxUnusedTextures = 16;
+
+    // Takes a reference on the texture, which stays owned by the cache and
+    // valid until it is released or the scene graph of window is invalidated.
+    // Call from the render thread while it is synchronizing.
+    QSGTexture *texture(QQuickWindow *window, const Key &key);
+    // Drops a reference taken by texture(), does nothing when the texture was
+    // already dropped along with the scene graph
+    void release(QQuickWindow *window, const Key &key, QSGTexture *texture);
+
+private:
+    struct Entry
+    {
+        QSGTexture *texture = nullptr;
+        int refs = 0;
+        // When the last reference was dropped, to evict the oldest first
+        quint64 releasedAt = 0;
+    };
+
+    explicit TShadowCache(QObject *parent = nullptr);
+
+    void releaseTextures(QQuickWindow *window);
+    void evictUnused(QHash<Key, Entry> &entries);
+
+    QHash<QQuickWindow *, QHash<Key, Entry>> m_textures;
+    quint64 m_releaseCount = 0;
+};
+
+size_t qHash(const TShadowCache::Key &key, size_t seed = 0);
@@ -0,0 +1,250 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tsoftwareeffects.h"
+
+#include "tquicksoftwareblur.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QVarLengthArray>
+#include <QtMath>
+
+#include <private/qsgplaintexture_p.h>
+#include <private/qsgsoftwarelayer_p.h>
+#include <private/qsgsoftwarepixmaptexture_p.h>
+
+#include <pixman.h>
+
+namespace {
+// Wraps the pixels of a 32 bit premultiplied image without copying them
+pixman_image_t *pixmanImage(const QImage &image)
+{
+    Q_ASSERT(image.format() == QImage::Format_ARGB32_Premultiplied);
+    return pixman_image_create_bits(PIXMAN_a8r8g8b8,
+                                    image.width(),
+                                    image.height(),
+                                    reinterpret_cast<uint32_t *>(const_cast<uchar *>(image.constBits())),
+                                    image.bytesPerLine());
+}
+
+// One pass along the rows, the first and last pixels repeat past the edges
+void boxBlurRows(QImage &image, int radius, quint32 scale)
+{
+    const int width = image.width();
+    QVarLengthArray<uchar, 4096> line(width * 4);
+
+    for (int y = 0; y < image.height(); ++y) {
+        uchar *pixels = image.scanLine(y);
+        memcpy(line.data(), pixels, width * 4);
+
+        quint32 sums[4];
+        for (int c = 0; c < 4; ++c) {
+            sums[c] = line[c] * (radius + 1);
+            for (int i = 1; i <= radius; ++i)
+                sums[c] += line[qMin(i, width - 1) * 4 + c];
+        }
+
+        for (int x = 0; x < width; ++x) {
+            const uchar *add = &line[qMin(x + radius + 1, width - 1) * 4];
+            const uchar *remove = &line[qMax(x - radius, 0) * 4];
+            // The four channels are independent lanes of one vector
+            for (int c = 0; c < 4; ++c) {
+                pixels[x * 4 + c] = uchar((sums[c] * scale + (1u << 23)) >> 24);
+                sums[c] += add[c] - remove[c];
+            }
+        }
+    }
+}
+
+// Slides the window down all columns at once, so every step is a loop over a
+// whole row without dependencies between its bytes
+void boxBlurColumns(QImage &image, int radius, quint32 scale)
+{
+    const int height = image.height();
+    const int length = image.width() * 4;
+    const QImage source = image.copy();
+    QVarLengthArray<quint32, 4096> sums(length);
+
+    const uchar *first = source.constScanLine(0);
+    for (int i = 0; i < length; ++i)
+        sums[i] = first[i] * (radius + 1);
+    for (int y = 1; y <= radius; ++y) {
+        const uchar *row = source.constScanLine(qMin(y, height - 1));
+        for (int i = 0; i < length; ++i)
+            sums[i] += row[i];
+    }
+
+    for (int y = 0; y < height; ++y) {
+        uchar *out = image.scanLine(y);
+        const uchar *add = source.constScanLine(qMin(y + radius + 1, height - 1));
+        const uchar *remove = source.constScanLine(qMax(y - radius, 0));
+        for (int i = 0; i < length; ++i) {
+            out[i] = uchar((sums[i] * scale + (1u << 23)) >> 24);
+            sums[i] += add[i] - remove[i];
+        }
+    }
+}
+} // namespace
+
+QImage TSoftwareEffects::textureImage(QSGTexture *texture)
+{
+    if (auto pixmapTexture = qobject_cast<QSGSoftwarePixmapTexture *>(texture))
+        return pixmapTexture->pixmap().toImage();
+    if (auto layer = qobject_cast<QSGSoftwareLayer *>(texture))
+        return layer->pixmap().toImage();
+    if (auto plainTexture = qobject_cast<QSGPlainTexture *>(texture))
+        return plainTexture->image();
+    if (auto blurTexture = qobject_cast<TSGSoftwareBlurTexture *>(texture))
+        return blurTexture->image();
+
+    return {};
+}
+
+QImage TSoftwareEffects::cornerMask(int radius, Qt::Corner corner)
+{
+    static QMutex mutex;
+    static QHash<QPair<int, int>, QImage> masks;
+
+    QMutexLocker locker(&mutex);
+    const auto key = qMakePair(radius, int(corner));
+    if (auto it = masks.constFind(key); it != masks.constEnd())
+        return *it;
+
+    const bool left = corner == Qt::TopLeftCorner || corner == Qt::BottomLeftCorner;
+    const bool top = corner == Qt::TopLeftCorner || corner == Qt::TopRightCorner;
+    const qreal centerX = left ? radius : 0;
+    const qreal centerY = top ? radius : 0;
+
+    QImage mask(radius, radius, QImage::Format_Alpha8);
+    for (int y = 0; y < radius; ++y) {
+        uchar *line = mask.scanLine(y);
+        for (int x = 0; x < radius; ++x) {
+            // Coverage falls off over one pixel around the arc
+            const qreal distance = qHypot(x + 0.5 - centerX, y + 0.5 - centerY);
+            line[x] = uchar(qBound(0.0, radius - distance + 0.5, 1.0) * 255 + 0.5);
+        }
+    }
+
+    // A handful of radii is in use at a time
+    if (masks.size() > 64)
+        masks.clear();
+    masks.insert(key, mask);
+    return mask;
+}
+
+void TSoftwareEffects::clipCorners(QImage &image,
+                                   int topLeft,
+                                   int topRight,
+                                   int bottomRight,
+                                   int bottomLeft)
+{
+    if (image.isNull() || (!topLeft && !topRight && !bottomRight && !bottomLeft))
+        return;
+
+    if (image.format() != QImage::Format_ARGB32_Premultiplied)
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+
+    const int limit = qMin(image.width(), image.height()) / 2;
+    const struct
+    {
+        int radius;
+        Qt::Corner corner;
+    } corners[] = {
+        { qMin(topLeft, limit), Qt::TopLeftCorner },
+        { qMin(topRight, limit), Qt::TopRightCorner },
+        { qMin(bottomRight, limit), Qt::BottomRightCorner },
+        { qMin(bottomLeft, limit), Qt::BottomLeftCorner },
+    };
+
+    // pixman writes behind the back of QImage, so the pixels must not be shared
+    image.detach();
+    pixman_image_t *target = pixmanImage(image);
+    for (const auto &corner : corners) {
+        if (corner.radius <= 0)
+            continue;
+
+        const QImage mask = cornerMask(corner.radius, corner.corner);
+        pixman_image_t *coverage =
+            pixman_image_create_bits(PIXMAN_a8,
+                                     mask.width(),
+                                     mask.height(),
+                                     reinterpret_cast<uint32_t *>(const_cast<uchar *>(mask.constBits())),
+                                     mask.bytesPerLine());
+        const bool left = corner.corner == Qt::TopLeftCorner || corner.corner == Qt::BottomLeftCorner;
+        const bool top = corner.corner == Qt::TopLeftCorner || corner.corner == Qt::TopRightCorner;
+        // IN_REVERSE keeps the destination scaled by the coverage of the source
+        pixman_image_composite32(PIXMAN_OP_IN_REVERSE,
+                                 coverage,
+                                 nullptr,
+                                 target,
+                                 0,
+                                 0,
+                                 0,
+                                 0,
+                                 left ? 0 : image.width() - corner.radius,
+                                 top ? 0 : image.height() - corner.radius,
+                                 corner.radius,
+                                 corner.radius);
+        pixman_image_unref(coverage);
+    }
+    pixman_image_unref(target);
+}
+
+void TSoftwareEffects::boxBlur(QImage &image, int radius, int passes)
+{
+    if (image.isNull() || radius <= 0)
+        return;
+
+    if (image.format() != QImage::Format_ARGB32_Premultiplied)
+        image.convertTo(QImage::Format_ARGB32_Premultiplied);
+
+    // Divides by the window with a rounded multiply, sums never exceed
+    // 255 * window so the product stays within 32 bits
+    const quint32 window = 2 * radius + 1;
+    const quint32 scale = ((1u << 24) + window / 2) / window;
+
+    for (int i = 0; i < passes; ++i) {
+        boxBlurRows(image, radius, scale);
+        boxBlurColumns(image, radius, scale);
+    }
+}
+
+QImage TSoftwareEffects::scaled(const QImage &image, const QSize &size)
+{
+    if (image.isNull() || size.isEmpty())
+        return {};
+
+    const QImage source = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (source.size() == size)
+        return source;
+
+    QImage result(size, QImage::Format_ARGB32_Premultiplied);
+    pixman_image_t *src = pixmanImage(source);
+    pixman_image_t *dst = pixmanImage(result);
+
+    pixman_transform_t transform;
+    pixman_transform_init_scale(&transform,
+                                pixman_double_to_fixed(qreal(source.width()) / size.width()),
+                                pixman_double_to_fixed(qreal(source.height()) / size.height()));
+    pixman_image_set_transform(src, &transform);
+    // GOOD filters with a box when shrinking, so downscaling does not alias
+    pixman_image_set_filter(src, PIXMAN_FILTER_GOOD, nullptr, 0);
+    pixman_image_set_repeat(src, PIXMAN_REPEAT_PAD);
+    pixman_image_composite32(PIXMAN_OP_SRC,
+                             src,
+                             nullptr,
+                             dst,
+                             0,
+                             0,
+                             0,
+                             0,
+                             0,
+                             0,
+                             size.width(),
+                             size.height());
+
+    pixman_image_unref(src);
+    pixman_image_unref(dst);
+    return result;
+}
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#pragma once
+
+#include <QImage>
+
+QT_BEGIN_NAMESPACE
+class QSGTexture;
+QT_END_NAMESPACE
+
+// CPU versions of the effects for the software scene graph backend. Scaling and
+// masking go through pixman, which picks its SIMD fast paths at runtime. The blur
+// kernels work on whole rows so the compiler can vectorize them.
+namespace TSoftwareEffects {
+
+// Pixels of a texture of the software backend, null for any other texture
+QImage textureImage(QSGTexture *texture);
+
+// Antialiased coverage of one rounded corner of radius pixels
+QImage cornerMask(int radius, Qt::Corner corner);
+
+// Makes the corners of a premultiplied image transparent, radii in pixels
+void clipCorners(QImage &image, int topLeft, int topRight, int bottomRight, int bottomLeft);
+
+// Box blurs a premultiplied image in place, three passes come close to a
+// gaussian reaching 3 * radius pixels. Edge pixels are repeated.
+void boxBlur(QImage &image, int radius, int passes = 3);
+
+// Premultiplied copy of image scaled to size with pixman's filtering
+QImage scaled(const QImage &image, const QSize &size);
+
+} // namespace TSoftwareEffects
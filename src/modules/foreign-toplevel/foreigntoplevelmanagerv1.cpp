@@ -1,6 +1,7 @@
 // Copyright (C) 2023 Dingyuan Zhang <lxz@mkacg.com>.
 // SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
+#include "config/treelandconfig.h"
 #include "core/rootsurfacecontainer.h"
 #include "seat/helper.h"
 #include "surface/surfacewrapper.h"
@@ -36,6 +37,14 @@ void ForeignToplevelV1::create(WServer *server)
 {
     m_manager = treeland_foreign_toplevel_manager_v1::create(server->handle());
 
+    m_manager->title_interval = TreelandConfig::ref().foreignToplevelTitleInterval();
+    connect(&TreelandConfig::ref(),
+            &TreelandConfig::foreignToplevelTitleIntervalChanged,
+            m_manager,
+            [this] {
+                m_manager->title_interval = TreelandConfig::ref().foreignToplevelTitleInterval();
+            });
+
     connect(m_manager,
             &treeland_foreign_toplevel_manager_v1::dockPreviewContextCreated,
             this,
@@ -61,6 +70,7 @@ void ForeignToplevelV1::addSurface(SurfaceWrapper *wrapper)
     auto handle = treeland_foreign_toplevel_handle_v1::create(m_manager);
     m_surfaces.insert({ wrapper, std::unique_ptr<treeland_foreign_toplevel_handle_v1>(handle) });
     auto surface = wrapper->shellSurface();
+    m_handles.insert(surface, handle);
 
     // initSurface
     surface->safeConnect(&WToplevelSurface::titleChanged, handle, [handle, surface] {
@@ -163,11 +173,9 @@ void ForeignToplevelV1::addSurface(SurfaceWrapper *wrapper)
                 handle->set_parent(nullptr);
                 return;
             }
-            for (const auto &[wrapper, phandle] : m_surfaces) {
-                if (wrapper->shellSurface() == p) {
-                    handle->set_parent(phandle.get());
-                    return;
-                }
+            if (auto phandle = m_handles.value(p)) {
+                handle->set_parent(phandle);
+                return;
             }
             qCCritical(qLcTreelandForeignToplevel)
                 << "Xdg toplevel surface " << xdgSurface
@@ -188,11 +196,9 @@ void ForeignToplevelV1::addSurface(SurfaceWrapper *wrapper)
                 handle->set_parent(nullptr);
                 return;
             }
-            for (const auto &[wrapper, phandle] : m_surfaces) {
-                if (wrapper->shellSurface() == p) {
-                    handle->set_parent(phandle.get());
-                    return;
-                }
+            if (auto phandle = m_handles.value(p)) {
+                handle->set_parent(phandle);
+                return;
             }
             qCCritical(qLcTreelandForeignToplevel)
                 << "X11 surface " << xwaylandSurface
@@ -212,6 +218,7 @@ void ForeignToplevelV1::addSurface(SurfaceWrapper *wrapper)
 
     handle->set_identifier(
         *reinterpret_cast<const uint32_t *>(surface->surface()->handle()->handle()));
+    m_identifiers.insert(handle->identifier, wrapper);
 
     handle->set_title(surface->title());
     handle->set_app_id(surface->appId());
@@ -223,10 +230,14 @@ void ForeignToplevelV1::addSurface(SurfaceWrapper *wrapper)
 
 void ForeignToplevelV1::removeSurface(SurfaceWrapper *wrapper)
 {
-    if (!m_surfaces.count(wrapper)) {
+    auto it = m_surfaces.find(wrapper);
+    if (it == m_surfaces.end()) {
         return;
     }
-    m_surfaces.erase(wrapper);
+    if (m_identifiers.value(it->second->identifier) == wrapper)
+        m_identifiers.remove(it->second->identifier);
+    m_handles.remove(wrapper->shellSurface());
+    m_surfaces.erase(it);
 }
 
 void ForeignToplevelV1::enterDockPreview(WSurface *relative_surface)
@@ -259,14 +270,8 @@ void ForeignToplevelV1::onDockPreviewContextCreated(treeland_dock_preview_contex
                 for (auto toplevelIt = event->toplevels.cbegin();
                      toplevelIt != event->toplevels.cend();
                      ++toplevelIt) {
-                    const uint32_t identifier = *toplevelIt;
-                    for (auto surfaceIt = m_surfaces.cbegin(); surfaceIt != m_surfaces.cend();
-                         ++surfaceIt) {
-                        if (surfaceIt->second->identifier == identifier) {
-                            surfaces.push_back(surfaceIt->first);
-                            break;
-                        }
-                    }
+                    if (auto wrapper = m_identifiers.value(*toplevelIt))
+                        surfaces.push_back(wrapper);
                 };
 
                 Q_EMIT requestDockPreview(surfaces,
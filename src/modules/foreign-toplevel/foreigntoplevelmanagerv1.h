@@ -8,8 +8,11 @@
 
 #include <wserver.h>
 #include <wsurface.h>
+#include <wtoplevelsurface.h>
 #include <wxdgsurface.h>
 
+#include <QHash>
+
 class SurfaceWrapper;
 
 QW_USE_NAMESPACE
@@ -63,6 +66,9 @@ private Q_SLOTS:
 private:
     treeland_foreign_toplevel_manager_v1 *m_manager = nullptr;
     std::map<SurfaceWrapper *, std::unique_ptr<treeland_foreign_toplevel_handle_v1>> m_surfaces;
+    // Lookup tables kept alongside m_surfaces
+    QHash<uint32_t, SurfaceWrapper *> m_identifiers;
+    QHash<WToplevelSurface *, treeland_foreign_toplevel_handle_v1 *> m_handles;
 };
 
 Q_DECLARE_OPAQUE_POINTER(treeland_foreign_toplevel_handle_v1_maximized_event *);
@@ -9,11 +9,15 @@
 #include <qwcompositor.h>
 #include <qwseat.h>
 
+#include <algorithm>
 #include <cassert>
+#include <utility>
 
 using QW_NAMESPACE::qw_display, QW_NAMESPACE::qw_output;
 
 #define FOREIGN_TOPLEVEL_MANAGEMENT_V1_VERSION 1
+// One frame at 60Hz, in milliseconds
+#define FOREIGN_TOPLEVEL_FLUSH_INTERVAL 16
 
 static void treeland_foreign_toplevel_handle_set_maximized(struct wl_client *client,
                                                            struct wl_resource *resource);
@@ -292,25 +296,10 @@ static void treeland_foreign_toplevel_handle_destroy([[maybe_unused]] struct wl_
     wl_resource_destroy(resource);
 }
 
-static void toplevel_idle_send_done(void *data)
+void treeland_foreign_toplevel_handle_v1::mark_pending(Pending change)
 {
-    auto *toplevel = static_cast<treeland_foreign_toplevel_handle_v1 *>(data);
-    struct wl_resource *resource;
-    wl_resource_for_each(resource, &toplevel->resources)
-    {
-        treeland_foreign_toplevel_handle_v1_send_done(resource);
-    }
-
-    toplevel->idle_source = nullptr;
-}
-
-void treeland_foreign_toplevel_handle_v1::update_idle_source()
-{
-    if (idle_source) {
-        return;
-    }
-
-    idle_source = wl_event_loop_add_idle(manager->event_loop, toplevel_idle_send_done, this);
+    pending.setFlag(change);
+    manager->schedule_flush(this);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_title(const QString &title)
@@ -319,13 +308,7 @@ void treeland_foreign_toplevel_handle_v1::set_title(const QString &title)
         return;
     this->title = title;
 
-    struct wl_resource *resource;
-    wl_resource_for_each(resource, &this->resources)
-    {
-        treeland_foreign_toplevel_handle_v1_send_title(resource, title.toUtf8());
-    }
-
-    update_idle_source();
+    mark_pending(Pending::Title);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_app_id(const QString &app_id)
@@ -334,13 +317,7 @@ void treeland_foreign_toplevel_handle_v1::set_app_id(const QString &app_id)
         return;
     this->app_id = app_id;
 
-    struct wl_resource *resource;
-    wl_resource_for_each(resource, &this->resources)
-    {
-        treeland_foreign_toplevel_handle_v1_send_app_id(resource, app_id.toLocal8Bit());
-    }
-
-    update_idle_source();
+    mark_pending(Pending::AppId);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_pid(const pid_t pid)
@@ -353,7 +330,7 @@ void treeland_foreign_toplevel_handle_v1::set_pid(const pid_t pid)
         treeland_foreign_toplevel_handle_v1_send_pid(resource, pid);
     }
 
-    update_idle_source();
+    mark_pending(Pending::Done);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_identifier(uint32_t identifier)
@@ -366,7 +343,7 @@ void treeland_foreign_toplevel_handle_v1::set_identifier(uint32_t identifier)
         treeland_foreign_toplevel_handle_v1_send_identifier(resource, identifier);
     }
 
-    update_idle_source();
+    mark_pending(Pending::Done);
 }
 
 static void send_output_to_resource(wl_resource *resource, wlr_output *output, bool enter)
@@ -394,7 +371,7 @@ void treeland_foreign_toplevel_handle_v1::send_output(qw_output *output, bool en
         send_output_to_resource(resource, output->handle(), enter);
     }
 
-    update_idle_source();
+    mark_pending(Pending::Done);
 }
 
 void treeland_foreign_toplevel_handle_v1::output_enter(qw_output *output)
@@ -421,7 +398,7 @@ void treeland_foreign_toplevel_handle_v1::output_enter(qw_output *output)
             }
         }
 
-        toplevel_output.toplevel->update_idle_source();
+        toplevel_output.toplevel->mark_pending(Pending::Done);
     });
 
     connect(output, &qw_output::before_destroy, this, [toplevel_output]() {
@@ -496,7 +473,6 @@ void treeland_foreign_toplevel_handle_v1::send_state()
     }
 
     wl_array_release(&states);
-    update_idle_source();
 }
 
 void treeland_foreign_toplevel_handle_v1::set_maximized(bool maximized)
@@ -505,7 +481,7 @@ void treeland_foreign_toplevel_handle_v1::set_maximized(bool maximized)
         return;
     }
     state.setFlag(State::Maximized, maximized);
-    send_state();
+    mark_pending(Pending::State);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_minimized(bool minimized)
@@ -514,7 +490,7 @@ void treeland_foreign_toplevel_handle_v1::set_minimized(bool minimized)
         return;
     }
     state.setFlag(State::Minimized, minimized);
-    send_state();
+    mark_pending(Pending::State);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_activated(bool activated)
@@ -523,7 +499,7 @@ void treeland_foreign_toplevel_handle_v1::set_activated(bool activated)
         return;
     }
     state.setFlag(State::Activated, activated);
-    send_state();
+    mark_pending(Pending::State);
 }
 
 void treeland_foreign_toplevel_handle_v1::set_fullscreen(bool fullscreen)
@@ -532,7 +508,58 @@ void treeland_foreign_toplevel_handle_v1::set_fullscreen(bool fullscreen)
         return;
     }
     state.setFlag(State::Fullscreen, fullscreen);
-    send_state();
+    mark_pending(Pending::State);
+}
+
+int treeland_foreign_toplevel_handle_v1::flush()
+{
+    int deferred = 0;
+    // Events like output enter or pid are sent right away, they only wait for done
+    bool sent = pending.testFlag(Pending::Done);
+    struct wl_resource *resource;
+
+    if (pending.testFlag(Pending::Title) && title == sent_title) {
+        pending.setFlag(Pending::Title, false);
+    } else if (pending.testFlag(Pending::Title)) {
+        const int interval = manager->title_interval;
+        if (interval > 0 && title_timer.isValid() && title_timer.elapsed() < interval) {
+            deferred = interval - title_timer.elapsed();
+        } else {
+            wl_resource_for_each(resource, &this->resources)
+            {
+                treeland_foreign_toplevel_handle_v1_send_title(resource, title.toUtf8());
+            }
+            sent_title = title;
+            title_timer.start();
+            pending.setFlag(Pending::Title, false);
+            sent = true;
+        }
+    }
+
+    if (pending.testFlag(Pending::AppId)) {
+        wl_resource_for_each(resource, &this->resources)
+        {
+            treeland_foreign_toplevel_handle_v1_send_app_id(resource, app_id.toLocal8Bit());
+        }
+        pending.setFlag(Pending::AppId, false);
+        sent = true;
+    }
+
+    if (pending.testFlag(Pending::State)) {
+        send_state();
+        pending.setFlag(Pending::State, false);
+        sent = true;
+    }
+
+    if (sent) {
+        wl_resource_for_each(resource, &this->resources)
+        {
+            treeland_foreign_toplevel_handle_v1_send_done(resource);
+        }
+        pending.setFlag(Pending::Done, false);
+    }
+
+    return deferred;
 }
 
 static void toplevel_resource_send_parent(struct wl_resource *toplevel_resource,
@@ -566,7 +593,7 @@ void treeland_foreign_toplevel_handle_v1::set_parent(treeland_foreign_toplevel_h
         toplevel_resource_send_parent(toplevel_resource, parent);
     }
     this->parent = parent;
-    update_idle_source();
+    mark_pending(Pending::Done);
 }
 
 void treeland_dock_preview_context_v1::enter()
@@ -603,9 +630,8 @@ treeland_foreign_toplevel_handle_v1::~treeland_foreign_toplevel_handle_v1()
 
     outputs.clear();
 
-    if (idle_source) {
-        wl_event_source_remove(idle_source);
-    }
+    manager->dirty_toplevels.removeOne(this);
+    manager->deferred_titles.removeOne(this);
 
     /* need to ensure no other toplevels hold a pointer to this one as
      * a parent, so that a later call to foreign_toplevel_manager_bind()
@@ -914,10 +940,71 @@ static void treeland_foreign_toplevel_manager_bind(struct wl_client *client,
 treeland_foreign_toplevel_manager_v1::~treeland_foreign_toplevel_manager_v1()
 {
     Q_EMIT before_destroy();
+    if (flush_source)
+        wl_event_source_remove(flush_source);
+    if (title_source)
+        wl_event_source_remove(title_source);
     if (global)
         wl_global_destroy(global);
 }
 
+static int manager_handle_flush_timer(void *data)
+{
+    auto *manager = static_cast<treeland_foreign_toplevel_manager_v1 *>(data);
+    manager->flush_scheduled = false;
+    manager->flush();
+    return 0;
+}
+
+static int manager_handle_title_timer(void *data)
+{
+    static_cast<treeland_foreign_toplevel_manager_v1 *>(data)->flush_deferred_titles();
+    return 0;
+}
+
+void treeland_foreign_toplevel_manager_v1::schedule_flush(
+    treeland_foreign_toplevel_handle_v1 *toplevel)
+{
+    if (!dirty_toplevels.contains(toplevel))
+        dirty_toplevels.append(toplevel);
+
+    if (flush_scheduled)
+        return;
+    flush_scheduled = true;
+    wl_event_source_timer_update(flush_source, FOREIGN_TOPLEVEL_FLUSH_INTERVAL);
+}
+
+void treeland_foreign_toplevel_manager_v1::flush()
+{
+    int next = 0;
+    const auto toplevels = std::exchange(dirty_toplevels, {});
+    for (auto toplevel : toplevels) {
+        const int deferred = toplevel->flush();
+        if (deferred > 0) {
+            if (!deferred_titles.contains(toplevel))
+                deferred_titles.append(toplevel);
+            next = next ? std::min(next, deferred) : deferred;
+        }
+    }
+
+    // Only ever moved earlier, a later deadline would starve titles deferred before
+    const qint64 remaining = title_deadline.remainingTime();
+    if (next > 0 && (remaining < 0 || next < remaining)) {
+        title_deadline.setRemainingTime(next);
+        wl_event_source_timer_update(title_source, next);
+    }
+}
+
+void treeland_foreign_toplevel_manager_v1::flush_deferred_titles()
+{
+    title_deadline = QDeadlineTimer(QDeadlineTimer::Forever);
+    for (auto toplevel : std::exchange(deferred_titles, {})) {
+        if (!dirty_toplevels.contains(toplevel))
+            dirty_toplevels.append(toplevel);
+    }
+    flush();
+}
+
 treeland_foreign_toplevel_manager_v1 *treeland_foreign_toplevel_manager_v1::create(
     QW_NAMESPACE::qw_display *display)
 {
@@ -927,6 +1014,10 @@ treeland_foreign_toplevel_manager_v1 *treeland_foreign_toplevel_manager_v1::crea
     }
 
     manager->event_loop = wl_display_get_event_loop(display->handle());
+    manager->flush_source =
+        wl_event_loop_add_timer(manager->event_loop, manager_handle_flush_timer, manager);
+    manager->title_source =
+        wl_event_loop_add_timer(manager->event_loop, manager_handle_title_timer, manager);
     manager->global = wl_global_create(display->handle(),
                                        &treeland_foreign_toplevel_manager_v1_interface,
                                        FOREIGN_TOPLEVEL_MANAGEMENT_V1_VERSION,
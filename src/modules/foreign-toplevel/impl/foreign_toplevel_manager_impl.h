@@ -8,6 +8,8 @@
 #include <qwdisplay.h>
 #include <qwoutput.h>
 
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
 #include <QList>
 #include <QObject>
 #include <QString>
@@ -28,6 +30,22 @@ public:
     QList<treeland_dock_preview_context_v1 *> dock_preview;
     QList<treeland_foreign_toplevel_handle_v1 *> toplevels;
 
+    // Toplevel changes are flushed together, at most once per frame interval
+    wl_event_source *flush_source{ nullptr };
+    bool flush_scheduled{ false };
+    QList<treeland_foreign_toplevel_handle_v1 *> dirty_toplevels;
+    // Minimum milliseconds between two titles of the same toplevel, 0 disables the limit
+    int title_interval{ 0 };
+    // Rate limited titles wait on their own timer, so they never hold back
+    // other changes flushed in the meantime
+    wl_event_source *title_source{ nullptr };
+    QDeadlineTimer title_deadline{ QDeadlineTimer::Forever };
+    QList<treeland_foreign_toplevel_handle_v1 *> deferred_titles;
+
+    void schedule_flush(treeland_foreign_toplevel_handle_v1 *toplevel);
+    void flush();
+    void flush_deferred_titles();
+
     static treeland_foreign_toplevel_manager_v1 *create(QW_NAMESPACE::qw_display *display);
 
 Q_SIGNALS:
@@ -88,10 +106,21 @@ public:
     Q_ENUM(State);
     Q_DECLARE_FLAGS(States, State)
 
+    enum class Pending
+    {
+        Title = 1,
+        AppId = 2,
+        State = 4,
+        Done = 8,
+    };
+    Q_DECLARE_FLAGS(PendingChanges, Pending)
+
     ~treeland_foreign_toplevel_handle_v1();
     treeland_foreign_toplevel_manager_v1 *manager{ nullptr };
     wl_list resources;
-    wl_event_source *idle_source{ nullptr };
+    PendingChanges pending;
+    QString sent_title;
+    QElapsedTimer title_timer;
 
     QString title;
     QString app_id;
@@ -116,6 +145,10 @@ public:
     void set_fullscreen(bool fullscreen);
     void set_parent(treeland_foreign_toplevel_handle_v1 *parent);
 
+    // Sends the pending changes followed by done, returns the milliseconds a rate
+    // limited title still has to wait or 0 if nothing is left
+    int flush();
+
     static treeland_foreign_toplevel_handle_v1 *create(
         treeland_foreign_toplevel_manager_v1 *manager);
 
@@ -129,7 +162,7 @@ Q_SIGNALS:
     void rectangleChanged(treeland_foreign_toplevel_handle_v1_set_rectangle_event *event);
 
 private:
-    void update_idle_source();
+    void mark_pending(Pending change);
     void send_state();
     void send_output(QW_NAMESPACE::qw_output *output, bool enter);
 
@@ -0,0 +1,270 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/directscanout.h"
+
+#include "output/output.h"
+#include "output/scanoututils.h"
+#include "seat/helper.h"
+#include "surface/surfacewrapper.h"
+#include "workspace/workspace.h"
+
+#include <woutput.h>
+#include <woutputitem.h>
+#include <woutputrenderwindow.h>
+#include <woutputviewport.h>
+#include <wsurface.h>
+#include <wsurfaceitem.h>
+
+#include <qwbuffer.h>
+#include <qwoutput.h>
+
+#include <QLoggingCategory>
+
+#include <time.h>
+
+Q_LOGGING_CATEGORY(qLcDirectScanout, "treeland.output.scanout", QtInfoMsg)
+
+DirectScanout::DirectScanout(Output *output)
+    : QObject(output)
+    , m_output(output)
+{
+    // Every change that matters reaches the screen through a frame of the render window
+    connect(Helper::instance()->window(),
+            &QQuickWindow::afterAnimating,
+            this,
+            &DirectScanout::update);
+}
+
+DirectScanout::~DirectScanout()
+{
+    if (m_surface)
+        stop(QStringLiteral("output removed"));
+}
+
+bool DirectScanout::isActive() const
+{
+    return m_active;
+}
+
+QString DirectScanout::blocker() const
+{
+    return m_blocker;
+}
+
+bool DirectScanout::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsEmpty("TREELAND_DISABLE_DIRECT_SCANOUT");
+    return enabled;
+}
+
+void DirectScanout::update()
+{
+    QString blocker;
+    SurfaceWrapper *candidate = findCandidate(&blocker);
+
+    if (m_rejected && m_rejected->surfaceState() != SurfaceWrapper::State::Fullscreen)
+        m_rejected = nullptr;
+    if (candidate && candidate == m_rejected) {
+        candidate = nullptr;
+        blocker = QStringLiteral("buffer rejected by the backend");
+    }
+
+    if (candidate == m_surface) {
+        if (!candidate)
+            setBlocker(blocker);
+        return;
+    }
+
+    if (m_surface)
+        stop(candidate ? QStringLiteral("fullscreen surface changed") : blocker);
+    else
+        setBlocker(blocker);
+
+    if (candidate)
+        start(candidate);
+}
+
+void DirectScanout::setBlocker(const QString &blocker)
+{
+    if (blocker == m_blocker)
+        return;
+
+    m_blocker = blocker;
+    qCDebug(qLcDirectScanout) << m_output->output()->name() << "is composited because of:" << blocker;
+}
+
+SurfaceWrapper *DirectScanout::findCandidate(QString *blocker) const
+{
+    if (!isEnabled()) {
+        *blocker = QStringLiteral("disabled");
+        return nullptr;
+    }
+
+    auto helper = Helper::instance();
+    if (helper->currentMode() != Helper::CurrentMode::Normal) {
+        *blocker = QStringLiteral("compositor mode");
+        return nullptr;
+    }
+    if (helper->outputMode() == Helper::OutputMode::Copy) {
+        *blocker = QStringLiteral("output is mirrored");
+        return nullptr;
+    }
+    if (m_output->outputItem()->property("forceSoftwareCursor").toBool()) {
+        *blocker = QStringLiteral("software cursor");
+        return nullptr;
+    }
+
+    SurfaceWrapper *candidate = nullptr;
+    const auto surfaces = m_output->surfaces();
+    for (auto surface : surfaces) {
+        if (surface->surfaceState() == SurfaceWrapper::State::Fullscreen && surface->isVisible()
+            && surface->showOnWorkspace(helper->workspace()->current()->id())) {
+            candidate = surface;
+            break;
+        }
+    }
+    if (!candidate) {
+        *blocker = QStringLiteral("no fullscreen surface");
+        return nullptr;
+    }
+
+    if (candidate->isAnimationRunning() || candidate->blur()
+        || !candidate->surface()->subsurfaces().isEmpty()) {
+        *blocker = QStringLiteral("fullscreen surface needs composition");
+        return nullptr;
+    }
+
+    auto surfaceItem = candidate->surfaceItem();
+    const QRectF outputRect = m_output->geometry();
+    if (!surfaceItem->mapRectToScene(surfaceItem->boundingRect()).contains(outputRect)) {
+        *blocker = QStringLiteral("fullscreen surface does not cover the output");
+        return nullptr;
+    }
+    if (!ScanoutUtils::isUncovered(surfaceItem, outputRect)) {
+        *blocker = QStringLiteral("output has overlays");
+        return nullptr;
+    }
+    if (!bufferFits(candidate->surface(), blocker))
+        return nullptr;
+
+    return candidate;
+}
+
+bool DirectScanout::bufferFits(WSurface *surface, QString *blocker) const
+{
+    qw_buffer *buffer = ScanoutUtils::clientBuffer(surface);
+    wlr_dmabuf_attributes attribs;
+    if (!buffer || !buffer->get_dmabuf(&attribs)) {
+        *blocker = QStringLiteral("buffer is not a dmabuf");
+        return false;
+    }
+
+    wlr_surface *handle = surface->handle()->handle();
+    wlr_output *output = m_output->output()->nativeHandle();
+    if (attribs.width != output->width || attribs.height != output->height
+        || handle->current.transform != output->transform || handle->current.viewport.has_src
+        || handle->current.viewport.has_dst) {
+        *blocker = QStringLiteral("buffer does not match the output mode");
+        return false;
+    }
+
+    if (!ScanoutUtils::isOpaque(surface, attribs.format)) {
+        *blocker = QStringLiteral("buffer is translucent");
+        return false;
+    }
+
+    return true;
+}
+
+bool DirectScanout::present()
+{
+    QString blocker;
+    if (!bufferFits(m_surface->surface(), &blocker)) {
+        stop(blocker);
+        return false;
+    }
+
+    auto qwoutput = m_output->output()->handle();
+    // Backends refuse buffers until the previous flip completed, that says
+    // nothing about the buffer itself
+    if (qwoutput->handle()->frame_pending) {
+        m_latched = true;
+        return true;
+    }
+
+    m_latched = false;
+    qw_output_state state;
+    state.set_buffer(*ScanoutUtils::clientBuffer(m_surface->surface()));
+    if (!qwoutput->test_state(state)) {
+        m_rejected = m_surface;
+        stop(QStringLiteral("buffer rejected by the backend"));
+        return false;
+    }
+    if (!qwoutput->commit_state(state)) {
+        stop(QStringLiteral("commit failed"));
+        return false;
+    }
+    return true;
+}
+
+void DirectScanout::start(SurfaceWrapper *surface)
+{
+    m_surface = surface;
+
+    // The output is no longer drawn by the render window, the client drives it
+    m_output->holdViewport(this);
+    m_commitConnection = surface->surface()->handle()->safeConnect(&qw_surface::notify_commit,
+                                                                   this,
+                                                                   &DirectScanout::onCommitted);
+    m_frameConnection =
+        connect(m_output->output()->handle(), &qw_output::notify_frame, this, &DirectScanout::onFrame);
+
+    if (!present())
+        return;
+
+    m_active = true;
+    m_blocker.clear();
+    qCInfo(qLcDirectScanout) << "Direct scanout started on" << m_output->output()->name()
+                             << "for" << surface->surface();
+    Q_EMIT activeChanged();
+}
+
+void DirectScanout::stop(const QString &blocker)
+{
+    if (!m_surface)
+        return;
+
+    m_surface = nullptr;
+    m_latched = false;
+    setBlocker(blocker);
+    QObject::disconnect(m_commitConnection);
+    QObject::disconnect(m_frameConnection);
+
+    m_output->releaseViewport(this);
+    m_output->screenViewport()->invalidate();
+
+    if (m_active) {
+        m_active = false;
+        qCInfo(qLcDirectScanout) << "Direct scanout stopped on" << m_output->output()->name()
+                                 << "because of:" << blocker;
+        Q_EMIT activeChanged();
+    }
+}
+
+void DirectScanout::onCommitted()
+{
+    present();
+}
+
+void DirectScanout::onFrame()
+{
+    if (!m_surface)
+        return;
+    if (m_latched && !present())
+        return;
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    wlr_surface_send_frame_done(m_surface->surface()->handle()->handle(), &now);
+}
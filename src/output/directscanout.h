@@ -0,0 +1,65 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wglobal.h>
+
+#include <QObject>
+#include <QPointer>
+
+WAYLIB_SERVER_BEGIN_NAMESPACE
+class WSurface;
+WAYLIB_SERVER_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+
+class Output;
+class SurfaceWrapper;
+
+// Presents the buffer of a fullscreen surface straight on the primary plane of
+// an output, skipping the Qt Quick composition of that output. Checked once per
+// frame of the render window; anything else that needs to be drawn on the
+// output (popups, notifications, a software cursor, effects, other modes)
+// hands the output back to the compositor right away.
+class DirectScanout : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DirectScanout(Output *output);
+    ~DirectScanout() override;
+
+    bool isActive() const;
+    // Why the output is composited, empty while scanning out
+    QString blocker() const;
+
+    // Disabled by setting TREELAND_DISABLE_DIRECT_SCANOUT
+    static bool isEnabled();
+
+Q_SIGNALS:
+    void activeChanged();
+
+private:
+    void update();
+    void setBlocker(const QString &blocker);
+    SurfaceWrapper *findCandidate(QString *blocker) const;
+    bool bufferFits(WSurface *surface, QString *blocker) const;
+    bool present();
+    void start(SurfaceWrapper *surface);
+    void stop(const QString &blocker);
+    void onCommitted();
+    void onFrame();
+
+    Output *m_output;
+    // Being presented, or tried right now
+    QPointer<SurfaceWrapper> m_surface;
+    bool m_active = false;
+    // Rejected by the backend, composited until it leaves fullscreen
+    QPointer<SurfaceWrapper> m_rejected;
+    // The client committed while a page flip was pending, its newest buffer
+    // goes out on the next frame event
+    bool m_latched = false;
+    QMetaObject::Connection m_commitConnection;
+    QMetaObject::Connection m_frameConnection;
+    QString m_blocker;
+};
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/framepacer.h"
+
+#include <algorithm>
+#include <utility>
+
+void FramePacer::addRenderTime(qint64 renderTime)
+{
+    m_renderTimes[m_nextRender] = renderTime;
+    m_nextRender = (m_nextRender + 1) % int(m_renderTimes.size());
+    m_renderCount = std::min(m_renderCount + 1, int(m_renderTimes.size()));
+}
+
+qint64 FramePacer::renderBudget() const
+{
+    if (m_renderCount < MinSamples)
+        return 0;
+
+    const qint64 slowest = *std::max_element(m_renderTimes.begin(),
+                                             m_renderTimes.begin() + m_renderCount);
+    return slowest + slowest / 4 + SafetyMargin;
+}
+
+qint64 FramePacer::renderDelay(qint64 refreshInterval) const
+{
+    if (m_renderCount < MinSamples || refreshInterval <= 0)
+        return 0;
+
+    const qint64 delay = refreshInterval - renderBudget();
+    // Waking up again costs more than a sub-millisecond gain
+    return delay >= 1'000'000 ? delay : 0;
+}
+
+void FramePacer::addClientCommit(qint64 timestamp)
+{
+    const qint64 interval = timestamp - m_lastClientCommit;
+    m_lastClientCommit = timestamp;
+    m_clientCommitPending = true;
+    if (interval <= 0 || interval > ClientIdleTimeout) {
+        m_clientInterval = 0;
+        return;
+    }
+
+    // Exponential moving average, settles within a few frames
+    m_clientInterval = m_clientInterval ? (m_clientInterval * 3 + interval) / 4 : interval;
+}
+
+void FramePacer::resetClient()
+{
+    m_lastClientCommit = 0;
+    m_clientInterval = 0;
+    m_clientCommitPending = false;
+}
+
+bool FramePacer::takeClientCommit()
+{
+    return std::exchange(m_clientCommitPending, false);
+}
+
+qint64 FramePacer::clientInterval(qint64 now) const
+{
+    return now - m_lastClientCommit > ClientIdleTimeout ? 0 : m_clientInterval;
+}
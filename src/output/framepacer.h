@@ -0,0 +1,47 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+
+// Timing decisions of FrameScheduler, kept apart to be testable. All times
+// are in nanoseconds of a monotonic clock.
+class FramePacer
+{
+public:
+    // Recent frames needed before rendering is delayed at all
+    static constexpr int MinSamples = 8;
+    // Kept free before the vblank besides the slowest recent frame
+    static constexpr qint64 SafetyMargin = 1'500'000;
+    // Commits further apart than this start a new measurement of the client
+    static constexpr qint64 ClientIdleTimeout = 200'000'000;
+
+    // Time from the start of rendering a frame to its commit
+    void addRenderTime(qint64 renderTime);
+    // Render time to plan for, the slowest recent frame with some headroom
+    qint64 renderBudget() const;
+    // How long to wait after the frame event before rendering, so that the
+    // frame is committed just in time for the vblank refreshInterval later
+    qint64 renderDelay(qint64 refreshInterval) const;
+
+    void addClientCommit(qint64 timestamp);
+    void resetClient();
+    // Whether the client committed since the last call, that commit is then
+    // taken. Called on every frame event, so a frame that already has a new
+    // client buffer is rendered instead of waiting for the next one.
+    bool takeClientCommit();
+    // Smoothed interval between the client's commits, 0 while unknown or
+    // when the client has been idle at now
+    qint64 clientInterval(qint64 now) const;
+
+private:
+    std::array<qint64, 16> m_renderTimes = {};
+    int m_renderCount = 0;
+    int m_nextRender = 0;
+
+    qint64 m_lastClientCommit = 0;
+    qint64 m_clientInterval = 0;
+    bool m_clientCommitPending = false;
+};
@@ -0,0 +1,216 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/framescheduler.h"
+
+#include "output/output.h"
+#include "seat/helper.h"
+#include "surface/surfacewrapper.h"
+
+#include <woutput.h>
+#include <woutputrenderwindow.h>
+#include <woutputviewport.h>
+#include <wsurface.h>
+
+#include <qwcompositor.h>
+#include <qwoutput.h>
+
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(qLcFrameScheduler, "treeland.output.frames", QtInfoMsg)
+
+namespace {
+// Slowest rate adaptive sync panels commonly go down to; the compositor
+// repeats frames for slower clients
+constexpr qint64 MaxAdaptiveInterval = 25'000'000;
+
+double toMsecs(qint64 nsecs)
+{
+    return nsecs / 1e6;
+}
+} // namespace
+
+FrameScheduler::FrameScheduler(Output *output)
+    : QObject(output)
+    , m_output(output)
+{
+    m_clock.start();
+    m_resumeTimer.setSingleShot(true);
+    m_resumeTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_resumeTimer, &QTimer::timeout, this, &FrameScheduler::resume);
+
+    // The render window only schedules its work on the frame event, pausing
+    // the viewport from here still holds back that frame
+    auto handle = output->output()->handle();
+    connect(handle, &qw_output::notify_frame, this, &FrameScheduler::onFrame);
+    connect(handle, &qw_output::notify_commit, this, &FrameScheduler::onCommitted);
+    connect(handle, &qw_output::notify_present, this, &FrameScheduler::onPresented);
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    QObject::disconnect(m_clientConnection);
+    resume();
+}
+
+QVariantMap FrameScheduler::timing() const
+{
+    return {
+        { QStringLiteral("refreshInterval"), toMsecs(m_refreshInterval) },
+        { QStringLiteral("presentInterval"), toMsecs(m_presentInterval) },
+        { QStringLiteral("renderTime"), toMsecs(m_renderTime) },
+        { QStringLiteral("renderDelay"), toMsecs(m_renderDelay) },
+        { QStringLiteral("clientInterval"), toMsecs(m_pacer.clientInterval(m_clock.nsecsElapsed())) },
+        { QStringLiteral("adaptiveSync"), adaptiveSync() },
+    };
+}
+
+bool FrameScheduler::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsEmpty("TREELAND_DISABLE_FRAME_PACING");
+    return enabled;
+}
+
+bool FrameScheduler::adaptiveSync() const
+{
+    return m_output->output()->nativeHandle()->adaptive_sync_status
+        == WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED;
+}
+
+qint64 FrameScheduler::refreshInterval() const
+{
+    // In mHz, 0 for outputs without a fixed refresh like nested ones
+    const int refresh = m_output->output()->nativeHandle()->refresh;
+    return refresh > 0 ? 1'000'000'000'000LL / refresh : 0;
+}
+
+// The client whose frames the output follows under adaptive sync
+void FrameScheduler::updateClient()
+{
+    SurfaceWrapper *client = nullptr;
+    if (adaptiveSync()) {
+        const auto surfaces = m_output->surfaces();
+        for (auto surface : surfaces) {
+            if (surface->surfaceState() == SurfaceWrapper::State::Fullscreen
+                && surface->isVisible()) {
+                client = surface;
+                break;
+            }
+        }
+        if (!client) {
+            auto activated = Helper::instance()->activatedSurface();
+            if (activated && m_output->hasSurface(activated))
+                client = activated;
+        }
+    }
+
+    if (client != m_client) {
+        QObject::disconnect(m_clientConnection);
+        m_pacer.resetClient();
+        m_client = client;
+        if (client) {
+            m_clientConnection =
+                client->surface()->handle()->safeConnect(&qw_surface::notify_commit,
+                                                         this,
+                                                         &FrameScheduler::onClientCommitted);
+        }
+    }
+
+    const qint64 interval = m_pacer.clientInterval(m_clock.nsecsElapsed());
+    m_followingClient = client && interval > 0 && interval < MaxAdaptiveInterval;
+}
+
+void FrameScheduler::pause()
+{
+    if (m_paused)
+        return;
+
+    m_paused = true;
+    m_output->holdViewport(this);
+}
+
+void FrameScheduler::resume()
+{
+    m_resumeTimer.stop();
+    m_renderStart = m_clock.nsecsElapsed();
+    if (!m_paused)
+        return;
+
+    m_paused = false;
+    m_output->releaseViewport(this);
+    Helper::instance()->window()->update();
+}
+
+void FrameScheduler::onFrame()
+{
+    m_resumeTimer.stop();
+    m_renderDelay = 0;
+    updateClient();
+    const bool clientCommitted = m_pacer.takeClientCommit();
+
+    if (!isEnabled() || m_output->directScanout()) {
+        resume();
+        return;
+    }
+
+    if (m_followingClient) {
+        // The client's buffer for this frame came in before the frame event
+        if (clientCommitted) {
+            resume();
+            return;
+        }
+        // Resumed by the client's commit, or at the slowest adaptive rate
+        pause();
+        m_resumeTimer.start(int(MaxAdaptiveInterval / 1'000'000));
+        return;
+    }
+
+    const qint64 refresh = m_refreshInterval > 0 ? m_refreshInterval : refreshInterval();
+    m_renderDelay = m_pacer.renderDelay(refresh);
+    if (m_renderDelay <= 0) {
+        resume();
+        return;
+    }
+
+    pause();
+    m_resumeTimer.start(int(m_renderDelay / 1'000'000));
+}
+
+void FrameScheduler::onCommitted(wlr_output_event_commit *event)
+{
+    if (!(event->state->committed & WLR_OUTPUT_STATE_BUFFER) || m_renderStart < 0)
+        return;
+
+    const qint64 renderTime = m_clock.nsecsElapsed() - m_renderStart;
+    m_renderStart = -1;
+    // Buffers of direct scanout, or a frame the render window skipped
+    if (m_output->directScanout() || (m_refreshInterval > 0 && renderTime > 2 * m_refreshInterval))
+        return;
+
+    m_renderTime = renderTime;
+    m_pacer.addRenderTime(renderTime);
+}
+
+void FrameScheduler::onPresented(wlr_output_event_present *event)
+{
+    if (!event->presented || !event->when)
+        return;
+
+    m_refreshInterval = event->refresh > 0 ? event->refresh : refreshInterval();
+    const qint64 when = qint64(event->when->tv_sec) * 1'000'000'000 + event->when->tv_nsec;
+    m_presentInterval = m_lastPresent ? when - m_lastPresent : 0;
+    m_lastPresent = when;
+
+    qCDebug(qLcFrameScheduler) << m_output->output()->name() << timing();
+    Q_EMIT timingChanged();
+}
+
+void FrameScheduler::onClientCommitted()
+{
+    m_pacer.addClientCommit(m_clock.nsecsElapsed());
+    if (m_paused && m_followingClient) {
+        // This frame shows the commit, the next one waits for a new commit
+        m_pacer.takeClientCommit();
+        resume();
+    }
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include "output/framepacer.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPointer>
+#include <QTimer>
+#include <QVariantMap>
+
+struct wlr_output_event_commit;
+struct wlr_output_event_present;
+
+class Output;
+class SurfaceWrapper;
+
+// Decides when the render window draws the next frame of an output. With
+// adaptive sync active and a fullscreen or focused client on the output, a
+// frame waits for that client's next commit, so the display refreshes at the
+// client's rate. Otherwise rendering is held back after the frame event until
+// just before the vblank, by the slowest recent frame plus a margin, which
+// shortens the time from input to photons. Rendering is held with a hold on
+// the output's viewport, see Output::holdViewport.
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit FrameScheduler(Output *output);
+    ~FrameScheduler() override;
+
+    // Timing of the last presented frame, all durations in milliseconds:
+    // refreshInterval, presentInterval, renderTime, renderDelay,
+    // clientInterval and adaptiveSync
+    QVariantMap timing() const;
+
+    // Disabled by setting TREELAND_DISABLE_FRAME_PACING
+    static bool isEnabled();
+
+Q_SIGNALS:
+    void timingChanged();
+
+private:
+    bool adaptiveSync() const;
+    qint64 refreshInterval() const;
+    void updateClient();
+    void pause();
+    void resume();
+    void onFrame();
+    void onCommitted(wlr_output_event_commit *event);
+    void onPresented(wlr_output_event_present *event);
+    void onClientCommitted();
+
+    Output *m_output;
+    FramePacer m_pacer;
+    QElapsedTimer m_clock;
+    QTimer m_resumeTimer;
+    bool m_paused = false;
+    bool m_followingClient = false;
+    // Clock time rendering of the pending frame was allowed to start, -1 when none
+    qint64 m_renderStart = -1;
+
+    QPointer<SurfaceWrapper> m_client;
+    QMetaObject::Connection m_clientConnection;
+
+    qint64 m_refreshInterval = 0;
+    qint64 m_lastPresent = 0;
+    qint64 m_presentInterval = 0;
+    qint64 m_renderTime = 0;
+    qint64 m_renderDelay = 0;
+};
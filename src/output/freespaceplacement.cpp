@@ -0,0 +1,149 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/freespaceplacement.h"
+
+#include <algorithm>
+
+void FreeSpacePlacement::setArea(const QRectF &area)
+{
+    if (m_area == area)
+        return;
+    m_area = area;
+    m_dirty = true;
+}
+
+QRectF FreeSpacePlacement::area() const
+{
+    return m_area;
+}
+
+void FreeSpacePlacement::insert(const void *key, const QRectF &rect)
+{
+    auto it = m_occupied.find(key);
+    if (it != m_occupied.end()) {
+        if (*it == rect)
+            return;
+        // The old rectangle can't be given back to the free list in place
+        *it = rect;
+        m_dirty = true;
+        return;
+    }
+
+    m_occupied.insert(key, rect);
+    if (!m_dirty)
+        occupy(rect);
+}
+
+void FreeSpacePlacement::remove(const void *key)
+{
+    if (m_occupied.remove(key))
+        m_dirty = true;
+}
+
+bool FreeSpacePlacement::contains(const void *key) const
+{
+    return m_occupied.contains(key);
+}
+
+void FreeSpacePlacement::clear()
+{
+    m_occupied.clear();
+    m_dirty = true;
+}
+
+std::optional<QPointF> FreeSpacePlacement::findPosition(const QSizeF &size)
+{
+    if (m_dirty)
+        rebuild();
+
+    const QPointF areaCenter = m_area.center();
+    std::optional<QPointF> best;
+    qreal bestShortSide = 0;
+    qreal bestDistance = 0;
+
+    for (const auto &rect : std::as_const(m_freeRects)) {
+        const qreal dw = rect.width() - size.width();
+        const qreal dh = rect.height() - size.height();
+        if (dw < 0 || dh < 0)
+            continue;
+
+        // Best short side fit, ties go to the place closest to the area center
+        const qreal shortSide = qMin(dw, dh);
+        const QPointF delta = rect.center() - areaCenter;
+        const qreal distance = QPointF::dotProduct(delta, delta);
+        if (best && (shortSide > bestShortSide
+                     || (qFuzzyCompare(shortSide, bestShortSide) && distance >= bestDistance)))
+            continue;
+
+        best = rect.center() - QPointF(size.width() / 2, size.height() / 2);
+        bestShortSide = shortSide;
+        bestDistance = distance;
+    }
+
+    return best;
+}
+
+const QList<QRectF> &FreeSpacePlacement::freeRects()
+{
+    if (m_dirty)
+        rebuild();
+    return m_freeRects;
+}
+
+void FreeSpacePlacement::rebuild()
+{
+    m_dirty = false;
+    m_freeRects.clear();
+    if (m_area.isEmpty())
+        return;
+
+    m_freeRects.append(m_area);
+    for (const auto &rect : std::as_const(m_occupied))
+        occupy(rect);
+}
+
+void FreeSpacePlacement::occupy(const QRectF &occupied)
+{
+    const QRectF rect = occupied & m_area;
+    if (rect.isEmpty())
+        return;
+
+    QList<QRectF> splits;
+    for (auto it = m_freeRects.begin(); it != m_freeRects.end();) {
+        const QRectF free = *it;
+        if (!free.intersects(rect)) {
+            ++it;
+            continue;
+        }
+
+        // Keep the maximal parts of free on each side of rect
+        if (rect.left() > free.left())
+            splits.append({ free.left(), free.top(), rect.left() - free.left(), free.height() });
+        if (rect.right() < free.right())
+            splits.append({ rect.right(), free.top(), free.right() - rect.right(), free.height() });
+        if (rect.top() > free.top())
+            splits.append({ free.left(), free.top(), free.width(), rect.top() - free.top() });
+        if (rect.bottom() < free.bottom())
+            splits.append({ free.left(), rect.bottom(), free.width(), free.bottom() - rect.bottom() });
+        it = m_freeRects.erase(it);
+    }
+
+    // Only the new parts can be contained by another rectangle, untouched ones were
+    // maximal before and don't intersect rect
+    for (qsizetype i = 0; i < splits.size(); ++i) {
+        const QRectF &split = splits.at(i);
+        const auto containedBy = [&split](const QRectF &other) {
+            return other.contains(split);
+        };
+        if (std::any_of(m_freeRects.cbegin(), m_freeRects.cend(), containedBy))
+            continue;
+        bool redundant = false;
+        for (qsizetype j = 0; j < splits.size() && !redundant; ++j) {
+            // Of two equal splits the first one is kept
+            redundant = j != i && splits.at(j).contains(split) && (splits.at(j) != split || j < i);
+        }
+        if (!redundant)
+            m_freeRects.append(split);
+    }
+}
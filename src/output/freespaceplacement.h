@@ -0,0 +1,39 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QRectF>
+
+#include <optional>
+
+// Tracks the free space of an area as the set of maximal free rectangles left
+// by the occupied rectangles. Adding a rectangle splits the free rectangles in
+// place, removing or moving one rebuilds them lazily on the next query.
+class FreeSpacePlacement
+{
+public:
+    void setArea(const QRectF &area);
+    QRectF area() const;
+
+    // Insert or update the occupied rectangle of key
+    void insert(const void *key, const QRectF &rect);
+    void remove(const void *key);
+    bool contains(const void *key) const;
+    void clear();
+
+    // Top left of the best fitting free place for size, none if nothing fits
+    std::optional<QPointF> findPosition(const QSizeF &size);
+
+    const QList<QRectF> &freeRects();
+
+private:
+    void rebuild();
+    void occupy(const QRectF &rect);
+
+    QRectF m_area;
+    QHash<const void *, QRectF> m_occupied;
+    QList<QRectF> m_freeRects;
+    bool m_dirty = true;
+};
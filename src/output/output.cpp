@@ -5,6 +5,11 @@
 
 #include "config/treelandconfig.h"
 #include "core/rootsurfacecontainer.h"
+#include "output/directscanout.h"
+#include "output/framescheduler.h"
+#include "output/outputconfigstore.h"
+#include "output/outputmirror.h"
+#include "output/planeassigner.h"
 #include "seat/helper.h"
 #include "surface/surfacewrapper.h"
 #include "workspace/workspace.h"
@@ -31,6 +36,58 @@
 
 Q_LOGGING_CATEGORY(qLcOutput, "treeland.output")
 
+namespace {
+// Fills state with what the user last applied to the monitor behind output.
+// Without adaptive sync it only fills in a configuration that had it on.
+bool loadSavedState(WOutput *output, qw_output_state &state, bool adaptiveSync)
+{
+    const auto config = OutputConfigStore().config(OutputConfigStore::identity(output));
+    if (!config || (!adaptiveSync && !config->adaptiveSync))
+        return false;
+
+    wlr_output *handle = output->nativeHandle();
+    if (wl_list_empty(&handle->modes)) {
+        // Nested and virtual outputs take any size
+        state.set_custom_mode(config->modeSize.width(), config->modeSize.height(), config->refresh);
+    } else {
+        wlr_output_mode *mode = nullptr;
+        wlr_output_mode *candidate;
+        wl_list_for_each(candidate, &handle->modes, link)
+        {
+            if (candidate->width == config->modeSize.width()
+                && candidate->height == config->modeSize.height()
+                && (!config->refresh || candidate->refresh == config->refresh)) {
+                mode = candidate;
+                break;
+            }
+        }
+        // The monitor behind this EDID no longer offers that mode
+        if (!mode)
+            return false;
+        state.set_mode(mode);
+    }
+
+    state.set_scale(config->scale);
+    state.set_transform(static_cast<wl_output_transform>(config->transform));
+    if (adaptiveSync && config->adaptiveSync)
+        state.set_adaptive_sync_enabled(true);
+    state.set_enabled(true);
+    return true;
+}
+
+bool commitSavedState(WOutput *output, bool adaptiveSync)
+{
+    qw_output_state state;
+    if (!loadSavedState(output, state, adaptiveSync) || !output->handle()->test_state(state))
+        return false;
+    if (output->handle()->commit_state(state))
+        return true;
+
+    qCWarning(qLcOutput) << "Committing the saved configuration of" << output->name() << "failed";
+    return false;
+}
+} // namespace
+
 Output *Output::create(WOutput *output, QQmlEngine *engine, QObject *parent)
 {
     auto isSoftwareCursor = [](WOutput *output) -> bool {
@@ -45,23 +102,36 @@ Output *Output::create(WOutput *output, QQmlEngine *engine, QObject *parent)
     QQmlEngine::setObjectOwnership(outputItem, QQmlEngine::CppOwnership);
     outputItem->setOutput(output);
 
-    connect(&TreelandConfig::ref(),
-            &TreelandConfig::forceSoftwareCursorChanged,
-            obj,
-            [obj, output, isSoftwareCursor]() {
-                auto forceSoftwareCursor = isSoftwareCursor(output);
-                qCInfo(qLcOutput) << "forceSoftwareCursor changed to" << forceSoftwareCursor;
-                obj->setProperty("forceSoftwareCursor", forceSoftwareCursor);
-            });
-
     auto o = new Output(outputItem, parent);
     o->m_type = Type::Primary;
     obj->setParent(o);
 
+    // The x11 backend has no cursor plane
+    if (output->handle()->is_x11())
+        o->holdSoftwareCursor(o);
+    auto updateConfigCursor = [o] {
+        auto config = &TreelandConfig::ref();
+        if (config->forceSoftwareCursor())
+            o->holdSoftwareCursor(config);
+        else
+            o->releaseSoftwareCursor(config);
+    };
+    updateConfigCursor();
+    connect(&TreelandConfig::ref(),
+            &TreelandConfig::forceSoftwareCursorChanged,
+            o,
+            [updateConfigCursor]() {
+                qCInfo(qLcOutput) << "forceSoftwareCursor changed to"
+                                  << TreelandConfig::ref().forceSoftwareCursor();
+                updateConfigCursor();
+            });
+
     o->minimizedSurfaces->setFilter([](SurfaceWrapper *s) {
         return s->isMinimized();
     });
 
+    o->updateScanoutHelpers();
+
     // Triggering layout updates using a queue helps reduce window jitter.
     // When the screen scaling factor changes, the scale of WOutput is updated first,
     // causing the size of WOutputItem to change. However, at this point, the
@@ -91,35 +161,6 @@ Output *Output::create(WOutput *output, QQmlEngine *engine, QObject *parent)
     return o;
 }
 
-Output *Output::createCopy(WOutput *output, Output *proxy, QQmlEngine *engine, QObject *parent)
-{
-    QQmlComponent delegate(engine, "Treeland", "CopyOutput");
-    QObject *obj = delegate.createWithInitialProperties(
-        {
-            { "targetOutputItem", QVariant::fromValue(proxy->outputItem()) },
-        },
-        engine->rootContext());
-    WOutputItem *outputItem = qobject_cast<WOutputItem *>(obj);
-    Q_ASSERT(outputItem);
-    QQmlEngine::setObjectOwnership(outputItem, QQmlEngine::CppOwnership);
-    outputItem->setOutput(output);
-
-    auto o = new Output(outputItem, parent);
-    o->m_type = Type::Proxy;
-    o->m_proxy = proxy;
-    obj->setParent(o);
-
-    auto contentItem = Helper::instance()->window()->contentItem();
-    outputItem->setParentItem(contentItem);
-    o->updateOutputHardwareLayers();
-    connect(o->m_outputViewport,
-            &WOutputViewport::hardwareLayersChanged,
-            o,
-            &Output::updateOutputHardwareLayers);
-
-    return o;
-}
-
 Output::Output(WOutputItem *output, QObject *parent)
     : SurfaceListModel(parent)
     , m_item(output)
@@ -130,6 +171,12 @@ Output::Output(WOutputItem *output, QObject *parent)
 
 Output::~Output()
 {
+    // Hands the viewport and its layers back to the render window before they go away
+    delete m_frameScheduler;
+    delete m_directScanout;
+    delete m_planeAssigner;
+    delete m_mirror;
+
     if (m_taskBar) {
         delete m_taskBar;
         m_taskBar = nullptr;
@@ -153,6 +200,46 @@ bool Output::isPrimary() const
     return m_type == Type::Primary;
 }
 
+Output *Output::proxy() const
+{
+    return m_proxy;
+}
+
+void Output::setProxy(Output *proxy)
+{
+    Q_ASSERT(proxy != this);
+    if (proxy == m_proxy)
+        return;
+
+    if (m_proxy) {
+        delete m_mirror;
+        m_mirror = nullptr;
+        disconnect(m_proxy->screenViewport(),
+                   &WOutputViewport::hardwareLayersChanged,
+                   this,
+                   &Output::updateOutputHardwareLayers);
+        for (auto layer : std::as_const(m_hardwareLayersOfPrimaryOutput))
+            Helper::instance()->window()->detach(layer, m_outputViewport);
+        m_hardwareLayersOfPrimaryOutput.clear();
+    }
+
+    m_proxy = proxy;
+    m_type = proxy ? Type::Proxy : Type::Primary;
+    // Stops direct scanout before the mirror takes the viewport over
+    updateScanoutHelpers();
+    // Only rebinds the viewport's input, the items of the output stay
+    m_item->setProperty("targetOutputItem", QVariant::fromValue(proxy ? proxy->outputItem() : nullptr));
+
+    if (proxy) {
+        m_mirror = new OutputMirror(this, proxy);
+        updateOutputHardwareLayers();
+        connect(proxy->screenViewport(),
+                &WOutputViewport::hardwareLayersChanged,
+                this,
+                &Output::updateOutputHardwareLayers);
+    }
+}
+
 void Output::updatePositionFromLayout()
 {
     WOutputLayout *layout = output()->layout();
@@ -167,16 +254,6 @@ QQuickItem *Output::outputMenuBar() const
     return m_menuBar;
 }
 #endif
-std::pair<WOutputViewport *, QQuickItem *> Output::getOutputItemProperty()
-{
-    WOutputViewport *viewportCopy =
-        outputItem()->findChild<WOutputViewport *>({}, Qt::FindDirectChildrenOnly);
-    Q_ASSERT(viewportCopy);
-    auto textureProxy = outputItem()->findChild<WQuickTextureProxy *>();
-    Q_ASSERT(textureProxy);
-    return std::make_pair(viewportCopy, textureProxy);
-}
-
 void Output::placeUnderCursor(SurfaceWrapper *surface, quint32 yOffset)
 {
     QSizeF cursorSize;
@@ -248,6 +325,32 @@ void Output::placeSmartCascaded(SurfaceWrapper *surface)
     surface->moveNormalGeometryInOutput(newPos);
 }
 
+bool Output::placeInFreeSpace(SurfaceWrapper *surface)
+{
+    // The surface itself must not take up the space it's placed in
+    m_freeSpace.remove(surface);
+    m_freeSpace.setArea(validGeometry());
+
+    const auto pos = m_freeSpace.findPosition(surface->normalGeometry().size());
+    if (!pos)
+        return false;
+
+    surface->moveNormalGeometryInOutput(*pos);
+    // geometryChanged waits for polish, windows placed in the same frame must
+    // already see this one
+    m_freeSpace.insert(surface, QRectF(*pos, surface->normalGeometry().size()));
+    m_freeSpacePlaced.insert(surface);
+    return true;
+}
+
+void Output::updateFreeSpace(SurfaceWrapper *surface)
+{
+    if (surface->isVisible())
+        m_freeSpace.insert(surface, surface->geometry());
+    else
+        m_freeSpace.remove(surface);
+}
+
 QPointF Output::calculateBottomRightPosition(const QRectF &activeGeo,
                                              const QRectF &normalGeo,
                                              const QRectF &validGeo,
@@ -343,16 +446,24 @@ void Output::enable()
     if (!qwoutput->property("_Enabled").toBool()) {
         qwoutput->setProperty("_Enabled", true);
 
+        // The user's configuration goes into this very first commit, so the
+        // session tools don't need a second modeset
+        // Monitors can lose adaptive sync, e.g. behind another cable, that
+        // alone doesn't throw away the saved mode, scale and transform
+        if (commitSavedState(output(), true) || commitSavedState(output(), false))
+            return;
+        if (OutputConfigStore().config(OutputConfigStore::identity(output()))) {
+            qCWarning(qLcOutput) << "Saved configuration of" << output()->name()
+                                 << "was rejected, using the preferred mode";
+        }
+
         if (!qwoutput->handle()->current_mode) {
             auto mode = qwoutput->preferred_mode();
             if (mode) {
                 newState.set_mode(mode);
-
-                // TODO: read user config
                 newState.set_scale(preferredScaleFactor({ mode->width, mode->height }));
             }
         } else {
-            // TODO: read user config
             newState.set_scale(preferredScaleFactor(output()->size()));
         }
         newState.set_enabled(true);
@@ -363,23 +474,60 @@ void Output::enable()
 
 void Output::updateOutputHardwareLayers()
 {
-    WOutputViewport *viewportPrimary = screenViewport();
-    std::pair<WOutputViewport *, QQuickItem *> copyOutput = getOutputItemProperty();
+    if (!m_proxy)
+        return;
+
+    WOutputViewport *viewportPrimary = m_proxy->screenViewport();
+    auto textureProxy = m_item->findChild<WQuickTextureProxy *>(QStringLiteral("mirrorProxy"));
+    Q_ASSERT(textureProxy);
     const auto layers = viewportPrimary->hardwareLayers();
     for (auto layer : layers) {
         if (m_hardwareLayersOfPrimaryOutput.removeOne(layer))
             continue;
-        Helper::instance()->window()->attach(layer,
-                                             copyOutput.first,
-                                             viewportPrimary,
-                                             copyOutput.second);
+        Helper::instance()->window()->attach(layer, m_outputViewport, viewportPrimary, textureProxy);
     }
     for (auto oldLayer : std::as_const(m_hardwareLayersOfPrimaryOutput)) {
-        Helper::instance()->window()->detach(oldLayer, copyOutput.first);
+        Helper::instance()->window()->detach(oldLayer, m_outputViewport);
     }
     m_hardwareLayersOfPrimaryOutput = layers;
 }
 
+// Direct scanout, overlay planes and frame pacing are only for outputs
+// showing their own part of the layout
+void Output::updateScanoutHelpers()
+{
+    if (isPrimary() == bool(m_directScanout))
+        return;
+
+    if (isPrimary()) {
+        m_directScanout = new DirectScanout(this);
+        connect(m_directScanout,
+                &DirectScanout::activeChanged,
+                this,
+                &Output::directScanoutChanged);
+        m_planeAssigner = new PlaneAssigner(this);
+        connect(m_planeAssigner,
+                &PlaneAssigner::planeCountChanged,
+                this,
+                &Output::overlayPlanesChanged);
+        m_frameScheduler = new FrameScheduler(this);
+        connect(m_frameScheduler,
+                &FrameScheduler::timingChanged,
+                this,
+                &Output::frameTimingChanged);
+    } else {
+        delete m_frameScheduler;
+        m_frameScheduler = nullptr;
+        delete m_directScanout;
+        m_directScanout = nullptr;
+        delete m_planeAssigner;
+        m_planeAssigner = nullptr;
+        Q_EMIT directScanoutChanged();
+        Q_EMIT overlayPlanesChanged();
+        Q_EMIT frameTimingChanged();
+    }
+}
+
 void Output::addSurface(SurfaceWrapper *surface)
 {
     Q_ASSERT(!hasSurface(surface));
@@ -401,6 +549,16 @@ void Output::addSurface(SurfaceWrapper *surface)
         connect(surface, &SurfaceWrapper::heightChanged, this, layoutSurface);
         layoutSurface();
 
+        if (surface->type() != SurfaceWrapper::Type::XdgPopup
+            && surface->type() != SurfaceWrapper::Type::InputPopup) {
+            auto updateFreeSpace = [surface, this] {
+                this->updateFreeSpace(surface);
+            };
+            connect(surface, &SurfaceWrapper::geometryChanged, this, updateFreeSpace);
+            connect(surface, &SurfaceWrapper::visibleChanged, this, updateFreeSpace);
+            updateFreeSpace();
+        }
+
         auto setyOffset = [surface, this] {
             placeUnderCursor(surface, surface->autoPlaceYOffset());
         };
@@ -424,6 +582,8 @@ void Output::removeSurface(SurfaceWrapper *surface)
     Q_ASSERT(hasSurface(surface));
     SurfaceListModel::removeSurface(surface);
     surface->disconnect(this);
+    m_freeSpace.remove(surface);
+    m_freeSpacePlaced.remove(surface);
 
     if (surface->type() == SurfaceWrapper::Type::Layer) {
         if (auto ss = surface->shellSurface()) {
@@ -635,7 +795,18 @@ void Output::arrangeNonLayerSurface(SurfaceWrapper *surface, const QSizeF &sizeD
                 if (normalGeo.width() > outputValidGeometry.width()
                     || normalGeo.height() > outputValidGeometry.height())
                     surface->resize(outputValidGeometry.size());
-                if (surface->type() == SurfaceWrapper::Type::XdgToplevel) {
+                // Resizing a placed window must not make it jump to another spot
+                if (m_freeSpacePlaced.contains(surface)) {
+                    surface->moveNormalGeometryInOutput(
+                        constrainToValidArea(normalGeo.topLeft(),
+                                             surface->normalGeometry().size(),
+                                             outputValidGeometry));
+                    break;
+                }
+                // Cascade only when the output has no free place left
+                if (placeInFreeSpace(surface)) {
+                    break;
+                } else if (surface->type() == SurfaceWrapper::Type::XdgToplevel) {
                     placeSmartCascaded(surface);
                 } else {
                     placeCentered(surface);
@@ -843,6 +1014,57 @@ WOutputViewport *Output::screenViewport() const
     return m_outputViewport;
 }
 
+void Output::holdViewport(QObject *holder)
+{
+    if (m_viewportHolders.contains(holder))
+        return;
+
+    m_viewportHolders.insert(holder);
+    if (m_viewportHolders.size() == 1)
+        m_outputViewport->setLive(false);
+}
+
+void Output::releaseViewport(QObject *holder)
+{
+    if (!m_viewportHolders.remove(holder) || !m_viewportHolders.isEmpty())
+        return;
+
+    m_outputViewport->setLive(true);
+}
+
+void Output::holdSoftwareCursor(QObject *holder)
+{
+    if (m_softwareCursorHolders.contains(holder))
+        return;
+
+    m_softwareCursorHolders.insert(holder);
+    if (m_softwareCursorHolders.size() == 1)
+        m_item->setProperty("forceSoftwareCursor", true);
+}
+
+void Output::releaseSoftwareCursor(QObject *holder)
+{
+    if (!m_softwareCursorHolders.remove(holder) || !m_softwareCursorHolders.isEmpty())
+        return;
+
+    m_item->setProperty("forceSoftwareCursor", false);
+}
+
+bool Output::directScanout() const
+{
+    return m_directScanout && m_directScanout->isActive();
+}
+
+int Output::overlayPlanes() const
+{
+    return m_planeAssigner ? m_planeAssigner->planeCount() : 0;
+}
+
+QVariantMap Output::frameTiming() const
+{
+    return m_frameScheduler ? m_frameScheduler->timing() : QVariantMap();
+}
+
 QRectF Output::validGeometry() const
 {
     return geometry().marginsRemoved(m_exclusiveZone);
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 #pragma once
 
+#include "output/freespaceplacement.h"
 #include "surface/surfacecontainer.h"
 
 #include <wglobal.h>
@@ -10,6 +11,8 @@
 #include <QMargins>
 #include <QObject>
 #include <QQmlComponent>
+#include <QSet>
+#include <QVariantMap>
 
 Q_MOC_INCLUDE(<woutputitem.h>)
 
@@ -25,6 +28,10 @@ WAYLIB_SERVER_END_NAMESPACE
 
 WAYLIB_SERVER_USE_NAMESPACE
 
+class DirectScanout;
+class FrameScheduler;
+class OutputMirror;
+class PlaneAssigner;
 class SurfaceWrapper;
 
 class Output : public SurfaceListModel
@@ -36,6 +43,9 @@ class Output : public SurfaceListModel
     Q_PROPERTY(WOutputItem* outputItem MEMBER m_item CONSTANT)
     Q_PROPERTY(SurfaceListModel* minimizedSurfaces MEMBER minimizedSurfaces CONSTANT)
     Q_PROPERTY(WOutputViewport* screenViewport MEMBER m_outputViewport CONSTANT)
+    Q_PROPERTY(bool directScanout READ directScanout NOTIFY directScanoutChanged FINAL)
+    Q_PROPERTY(int overlayPlanes READ overlayPlanes NOTIFY overlayPlanesChanged FINAL)
+    Q_PROPERTY(QVariantMap frameTiming READ frameTiming NOTIFY frameTimingChanged FINAL)
 
 public:
     enum class Type
@@ -51,15 +61,15 @@ public:
     };
 
     static Output *create(WOutput *output, QQmlEngine *engine, QObject *parent = nullptr);
-    static Output *createCopy(WOutput *output,
-                              Output *proxy,
-                              QQmlEngine *engine,
-                              QObject *parent = nullptr);
 
     explicit Output(WOutputItem *output, QObject *parent = nullptr);
     ~Output() override;
 
     bool isPrimary() const;
+    Output *proxy() const;
+    // Mirrors proxy when set, or shows its own part of the layout again when
+    // null. The output item and its viewport are kept either way.
+    void setProxy(Output *proxy);
 
     void addSurface(SurfaceWrapper *surface) override;
     void removeSurface(SurfaceWrapper *surface) override;
@@ -73,6 +83,20 @@ public:
     QRectF validRect() const;
     QRectF validGeometry() const;
     WOutputViewport *screenViewport() const;
+    // The render window skips the viewport while anyone holds it, direct
+    // scanout, zero copy mirroring and frame pacing each take a hold
+    void holdViewport(QObject *holder);
+    void releaseViewport(QObject *holder);
+    // The cursor is drawn into the frames while anyone holds it, for the
+    // config, the x11 backend, nvidia cards and zero copy mirroring
+    void holdSoftwareCursor(QObject *holder);
+    void releaseSoftwareCursor(QObject *holder);
+    // True while a fullscreen surface is presented without composition
+    bool directScanout() const;
+    // Number of surfaces shown on overlay planes instead of being composited
+    int overlayPlanes() const;
+    // Timing of the last presented frame, see FrameScheduler::timing
+    QVariantMap frameTiming() const;
     void updatePositionFromLayout();
 #ifdef QT_DEBUG
     QQuickItem *outputMenuBar() const;
@@ -87,6 +111,9 @@ public:
 Q_SIGNALS:
     void exclusiveZoneChanged();
     void moveResizeFinised();
+    void directScanoutChanged();
+    void overlayPlanesChanged();
+    void frameTimingChanged();
 
 public Q_SLOTS:
     void enable();
@@ -103,11 +130,13 @@ private:
     void arrangePopupSurface(SurfaceWrapper *surface);
     void arrangeNonLayerSurfaces();
     void arrangeAllSurfaces();
-    std::pair<WOutputViewport *, QQuickItem *> getOutputItemProperty();
+    void updateScanoutHelpers();
     void placeUnderCursor(SurfaceWrapper *surface, quint32 yOffset);
     void placeClientRequstPos(SurfaceWrapper *surface, QPoint clientRequstPos);
     void placeCentered(SurfaceWrapper *surface);
     void placeSmartCascaded(SurfaceWrapper *surface);
+    bool placeInFreeSpace(SurfaceWrapper *surface);
+    void updateFreeSpace(SurfaceWrapper *surface);
     QPointF calculateBottomRightPosition(const QRectF &activeGeo,
                                          const QRectF &normalGeo,
                                          const QRectF &validGeo,
@@ -136,6 +165,12 @@ private:
     QPointer<QQuickItem> m_menuBar;
 #endif
     WOutputViewport *m_outputViewport = nullptr;
+    QSet<QObject *> m_viewportHolders;
+    QSet<QObject *> m_softwareCursorHolders;
+    DirectScanout *m_directScanout = nullptr;
+    PlaneAssigner *m_planeAssigner = nullptr;
+    FrameScheduler *m_frameScheduler = nullptr;
+    OutputMirror *m_mirror = nullptr;
 
     QMargins m_exclusiveZone;
     QList<std::pair<QObject *, int>> m_topExclusiveZones;
@@ -146,6 +181,10 @@ private:
     QSizeF m_lastSizeOnLayoutNonLayerSurfaces;
     QList<WOutputLayer *> m_hardwareLayersOfPrimaryOutput;
     PlaceDirection m_nextPlaceDirection = PlaceDirection::BottomRight;
+    // visible windows of the output, for placing new ones
+    FreeSpacePlacement m_freeSpace;
+    // Windows placed into the free space once, later resizes keep them in place
+    QSet<SurfaceWrapper *> m_freeSpacePlaced;
 
     QMap<SurfaceWrapper*, QPair<QPointF, QRectF>> m_positionCache;
 };
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/outputconfigstore.h"
+
+#include <woutput.h>
+
+#include <QSettings>
+#include <QStandardPaths>
+#include <QUrl>
+
+OutputConfigStore::OutputConfigStore(const QString &fileName)
+    : m_fileName(fileName)
+{
+}
+
+std::optional<OutputConfig> OutputConfigStore::config(const QString &identity) const
+{
+    QSettings settings(m_fileName, QSettings::IniFormat);
+    if (!settings.childGroups().contains(identity))
+        return std::nullopt;
+
+    settings.beginGroup(identity);
+    OutputConfig config;
+    config.modeSize = settings.value("modeSize").toSize();
+    if (!config.modeSize.isValid())
+        return std::nullopt;
+
+    config.refresh = settings.value("refresh", 0).toInt();
+    config.scale = settings.value("scale", 1.0).toReal();
+    config.transform = settings.value("transform", 0).toInt();
+    config.position = settings.value("position").toPoint();
+    config.primary = settings.value("primary", false).toBool();
+    config.adaptiveSync = settings.value("adaptiveSync", false).toBool();
+    return config;
+}
+
+void OutputConfigStore::setConfig(const QString &identity, const OutputConfig &config)
+{
+    QSettings settings(m_fileName, QSettings::IniFormat);
+    settings.beginGroup(identity);
+    settings.setValue("modeSize", config.modeSize);
+    settings.setValue("refresh", config.refresh);
+    settings.setValue("scale", config.scale);
+    settings.setValue("transform", config.transform);
+    settings.setValue("position", config.position);
+    settings.setValue("primary", config.primary);
+    settings.setValue("adaptiveSync", config.adaptiveSync);
+}
+
+void OutputConfigStore::setPrimary(const QString &identity)
+{
+    QSettings settings(m_fileName, QSettings::IniFormat);
+    const auto groups = settings.childGroups();
+    for (const auto &group : groups) {
+        if (group == identity)
+            continue;
+        settings.beginGroup(group);
+        settings.setValue("primary", false);
+        settings.endGroup();
+    }
+
+    settings.beginGroup(identity);
+    settings.setValue("primary", true);
+}
+
+bool OutputConfigStore::isPrimary(const QString &identity) const
+{
+    QSettings settings(m_fileName, QSettings::IniFormat);
+    settings.beginGroup(identity);
+    return settings.value("primary", false).toBool();
+}
+
+QString OutputConfigStore::defaultFileName()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericConfigLocation)
+        + QStringLiteral("/treeland/outputs.ini");
+}
+
+QString OutputConfigStore::identity(WOutput *output)
+{
+    wlr_output *handle = output->nativeHandle();
+    return identity(QString::fromUtf8(handle->make),
+                    QString::fromUtf8(handle->model),
+                    QString::fromUtf8(handle->serial),
+                    output->name());
+}
+
+QString OutputConfigStore::identity(const QString &make,
+                                    const QString &model,
+                                    const QString &serial,
+                                    const QString &name)
+{
+    const QString id = serial.isEmpty() ? QStringList{ make, model, name }.join('|')
+                                        : QStringList{ make, model, serial }.join('|');
+    // Group names of QSettings must not contain slashes
+    return QString::fromLatin1(QUrl::toPercentEncoding(id, " |"));
+}
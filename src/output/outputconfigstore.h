@@ -0,0 +1,62 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wglobal.h>
+
+#include <QPoint>
+#include <QSize>
+#include <QString>
+
+#include <optional>
+
+WAYLIB_SERVER_BEGIN_NAMESPACE
+class WOutput;
+WAYLIB_SERVER_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+
+// What the user last applied to a monitor
+struct OutputConfig
+{
+    QSize modeSize;
+    // In mHz, 0 for any refresh rate of modeSize
+    int refresh = 0;
+    qreal scale = 1.0;
+    // wl_output_transform
+    int transform = 0;
+    QPoint position;
+    bool primary = false;
+    bool adaptiveSync = false;
+
+    bool operator==(const OutputConfig &other) const = default;
+};
+
+// Keeps an OutputConfig per monitor, keyed by the make, model and serial of
+// its EDID so that it follows the monitor to any connector. Applied by the
+// first commit of an output, so that it starts in its final mode.
+class OutputConfigStore
+{
+public:
+    explicit OutputConfigStore(const QString &fileName = defaultFileName());
+
+    std::optional<OutputConfig> config(const QString &identity) const;
+    void setConfig(const QString &identity, const OutputConfig &config);
+    // Makes identity the only primary output, also when nothing else of it
+    // has been saved yet
+    void setPrimary(const QString &identity);
+    // Unlike config(), also true for a monitor that only has the primary flag
+    bool isPrimary(const QString &identity) const;
+
+    // $XDG_CONFIG_HOME/treeland/outputs.ini
+    static QString defaultFileName();
+    // The connector name stands in for outputs without EDID, like virtual ones
+    static QString identity(WOutput *output);
+    static QString identity(const QString &make,
+                            const QString &model,
+                            const QString &serial,
+                            const QString &name);
+
+private:
+    QString m_fileName;
+};
@@ -0,0 +1,181 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/outputmirror.h"
+
+#include "output/output.h"
+
+#include <woutput.h>
+#include <woutputitem.h>
+#include <woutputviewport.h>
+
+#include <qwbuffer.h>
+#include <qwoutput.h>
+
+#include <QLoggingCategory>
+
+Q_LOGGING_CATEGORY(qLcOutputMirror, "treeland.output.mirror", QtInfoMsg)
+
+OutputMirror::OutputMirror(Output *output, Output *source)
+    : QObject(output)
+    , m_output(output)
+    , m_source(source)
+{
+    auto sourceHandle = source->output()->handle();
+    connect(sourceHandle, &qw_output::notify_commit, this, &OutputMirror::onSourceCommitted);
+    // The copy's own commits tell about changes of its mode
+    connect(output->output()->handle(), &qw_output::notify_commit, this, &OutputMirror::update);
+    connect(output->output()->handle(), &qw_output::notify_frame, this, &OutputMirror::onFrame);
+    connect(source->screenViewport(),
+            &WOutputViewport::hardwareLayersChanged,
+            this,
+            &OutputMirror::update);
+
+    update();
+}
+
+OutputMirror::~OutputMirror()
+{
+    if (m_zeroCopy)
+        stop(QStringLiteral("mirror removed"));
+    setSoftwareCursor(false);
+}
+
+bool OutputMirror::isZeroCopy() const
+{
+    return m_zeroCopy;
+}
+
+bool OutputMirror::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsEmpty("TREELAND_DISABLE_ZERO_COPY_MIRROR");
+    return enabled;
+}
+
+void OutputMirror::update()
+{
+    wlr_output *copy = m_output->output()->nativeHandle();
+    if (m_rejectedSize != QSize(copy->width, copy->height))
+        m_rejectedSize = QSize();
+
+    const bool match = modesMatch();
+    setSoftwareCursor(match);
+
+    // Anything on a hardware layer of the source is missing from its buffers
+    const bool zeroCopy = match && m_source->screenViewport()->hardwareLayers().isEmpty();
+    if (zeroCopy == m_zeroCopy)
+        return;
+
+    if (zeroCopy)
+        start();
+    else
+        stop(QStringLiteral("outputs differ"));
+}
+
+bool OutputMirror::modesMatch() const
+{
+    if (!isEnabled() || !m_source)
+        return false;
+
+    wlr_output *copy = m_output->output()->nativeHandle();
+    wlr_output *source = m_source->output()->nativeHandle();
+    const QSize size(copy->width, copy->height);
+    if (size == m_rejectedSize)
+        return false;
+
+    return copy->enabled && source->enabled && size == QSize(source->width, source->height)
+        && copy->transform == source->transform;
+}
+
+void OutputMirror::setSoftwareCursor(bool force)
+{
+    if (!m_source)
+        return;
+
+    if (force)
+        m_source->holdSoftwareCursor(this);
+    else
+        m_source->releaseSoftwareCursor(this);
+}
+
+void OutputMirror::start()
+{
+    m_zeroCopy = true;
+    // The copy is no longer drawn by the render window, the source drives it
+    m_output->holdViewport(this);
+    // Have a buffer to show right away
+    m_source->screenViewport()->invalidate();
+
+    qCInfo(qLcOutputMirror) << "Mirroring" << m_source->output()->name() << "on"
+                            << m_output->output()->name() << "without copies";
+    Q_EMIT zeroCopyChanged();
+}
+
+void OutputMirror::stop(const QString &reason)
+{
+    if (!m_zeroCopy)
+        return;
+
+    m_zeroCopy = false;
+    m_waitingFrame = false;
+    if (m_pending) {
+        wlr_buffer_unlock(m_pending);
+        m_pending = nullptr;
+    }
+
+    m_output->releaseViewport(this);
+    m_output->screenViewport()->invalidate();
+
+    qCInfo(qLcOutputMirror) << "Mirroring on" << m_output->output()->name()
+                            << "through the compositor because of:" << reason;
+    Q_EMIT zeroCopyChanged();
+}
+
+void OutputMirror::present(wlr_buffer *buffer)
+{
+    if (m_waitingFrame) {
+        wlr_buffer_lock(buffer);
+        if (m_pending)
+            wlr_buffer_unlock(m_pending);
+        m_pending = buffer;
+        return;
+    }
+
+    auto handle = m_output->output()->handle();
+    qw_output_state state;
+    state.set_buffer(buffer);
+    if (!handle->test_state(state)) {
+        m_rejectedSize = QSize(handle->handle()->width, handle->handle()->height);
+        stop(QStringLiteral("buffer rejected by the backend"));
+        update();
+        return;
+    }
+    if (!handle->commit_state(state)) {
+        stop(QStringLiteral("commit failed"));
+        return;
+    }
+    m_waitingFrame = true;
+}
+
+void OutputMirror::onSourceCommitted(wlr_output_event_commit *event)
+{
+    constexpr uint32_t modeChanges =
+        WLR_OUTPUT_STATE_ENABLED | WLR_OUTPUT_STATE_MODE | WLR_OUTPUT_STATE_TRANSFORM;
+    if (!m_zeroCopy || (event->state->committed & modeChanges))
+        update();
+
+    if (m_zeroCopy && (event->state->committed & WLR_OUTPUT_STATE_BUFFER))
+        present(event->state->buffer);
+}
+
+void OutputMirror::onFrame()
+{
+    m_waitingFrame = false;
+    if (!m_zeroCopy || !m_pending)
+        return;
+
+    wlr_buffer *buffer = m_pending;
+    m_pending = nullptr;
+    present(buffer);
+    wlr_buffer_unlock(buffer);
+}
@@ -0,0 +1,55 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QObject>
+#include <QPointer>
+#include <QSize>
+
+struct wlr_buffer;
+struct wlr_output_event_commit;
+
+class Output;
+
+// Shows the buffers the render window commits to a primary output on one of
+// its copy outputs as they are, when both outputs have the same mode. The copy
+// is then neither composited nor scaled. Otherwise, or when the copy's backend
+// can not import the buffers, PrimaryOutput.qml scales the primary viewport in a
+// single texture pass. While mirroring as is, the cursor of the primary output
+// is drawn in software so that it is part of the mirrored buffers.
+class OutputMirror : public QObject
+{
+    Q_OBJECT
+
+public:
+    OutputMirror(Output *output, Output *source);
+    ~OutputMirror() override;
+
+    bool isZeroCopy() const;
+
+    // Disabled by setting TREELAND_DISABLE_ZERO_COPY_MIRROR
+    static bool isEnabled();
+
+Q_SIGNALS:
+    void zeroCopyChanged();
+
+private:
+    void update();
+    bool modesMatch() const;
+    void setSoftwareCursor(bool force);
+    void start();
+    void stop(const QString &reason);
+    void present(wlr_buffer *buffer);
+    void onSourceCommitted(wlr_output_event_commit *event);
+    void onFrame();
+
+    Output *m_output;
+    QPointer<Output> m_source;
+    bool m_zeroCopy = false;
+    // Set while a buffer is on its way to the screen of the copy
+    bool m_waitingFrame = false;
+    // Newest buffer of the source not yet shown, locked
+    wlr_buffer *m_pending = nullptr;
+    // Mode of the copy whose buffers were refused by the backend
+    QSize m_rejectedSize;
+};
@@ -0,0 +1,328 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/planeassigner.h"
+
+#include "output/output.h"
+#include "output/scanoututils.h"
+#include "seat/helper.h"
+#include "surface/surfacewrapper.h"
+#include "workspace/workspace.h"
+
+#include <woutput.h>
+#include <woutputlayer.h>
+#include <woutputrenderwindow.h>
+#include <woutputviewport.h>
+#include <wsurface.h>
+#include <wsurfaceitem.h>
+
+#include <qwbuffer.h>
+#include <qwcompositor.h>
+
+#include <QLoggingCategory>
+#include <QQmlEngine>
+#include <QSet>
+
+#include <algorithm>
+
+Q_LOGGING_CATEGORY(qLcPlaneAssigner, "treeland.output.planes", QtInfoMsg)
+
+namespace {
+// Below this a surface is not worth a plane, composition is cheap enough
+constexpr qreal MinimumArea = 1.0 / 64;
+// Commits per second, a surface redrawn less often gains little from a plane
+constexpr qreal MinimumCommitRate = 10;
+constexpr qint64 CommitRateWindow = 500;
+// A layer the backend has not taken after this many frames is refused
+constexpr int MaxPendingFrames = 3;
+// Keeps a promoted surface on its plane against candidates only slightly better
+constexpr qreal PromotedBonus = 1.25;
+// Milliseconds an occlusion result is trusted while the windows stay put
+constexpr qint64 OcclusionMaxAge = 250;
+
+// Surface items of a window, subsurfaces included, video often lives in one
+void collectItems(QQuickItem *item, QList<WSurfaceItem *> *items)
+{
+    if (!item->isVisible())
+        return;
+    if (auto surfaceItem = qobject_cast<WSurfaceItem *>(item))
+        items->append(surfaceItem);
+
+    const auto children = item->childItems();
+    for (auto child : children)
+        collectItems(child, items);
+}
+} // namespace
+
+PlaneAssigner::PlaneAssigner(Output *output)
+    : QObject(output)
+    , m_output(output)
+{
+    connect(Helper::instance()->window(),
+            &QQuickWindow::afterAnimating,
+            this,
+            &PlaneAssigner::update);
+}
+
+PlaneAssigner::~PlaneAssigner()
+{
+    for (auto &plane : m_planes)
+        demote(plane);
+    for (const auto &activity : std::as_const(m_activity))
+        QObject::disconnect(activity.connection);
+}
+
+int PlaneAssigner::planeCount() const
+{
+    return m_planeCount;
+}
+
+bool PlaneAssigner::isEnabled()
+{
+    static const bool enabled = qEnvironmentVariableIsEmpty("TREELAND_DISABLE_OVERLAY_PLANES");
+    return enabled;
+}
+
+int PlaneAssigner::planeBudget()
+{
+    static const int budget = [] {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("TREELAND_OVERLAY_PLANES", &ok);
+        return ok ? qMax(0, value) : 2;
+    }();
+    return budget;
+}
+
+void PlaneAssigner::update()
+{
+    m_sceneKeyChecked = false;
+    const auto hardwareLayers = m_output->screenViewport()->hardwareLayers();
+    for (auto &plane : m_planes) {
+        if (!plane.item || hardwareLayers.contains(plane.layer.data())) {
+            plane.pendingFrames = 0;
+            continue;
+        }
+        if (++plane.pendingFrames > MaxPendingFrames) {
+            qCDebug(qLcPlaneAssigner) << "Overlay plane refused on" << m_output->output()->name()
+                                      << "for" << plane.item->surface();
+            m_rejected.append(plane.item);
+            demote(plane);
+        }
+    }
+    m_planes.removeIf([](const Plane &plane) {
+        return !plane.item;
+    });
+
+    const auto candidates = findCandidates();
+    m_rejected.removeIf([&candidates](const QPointer<WSurfaceItem> &item) {
+        return std::none_of(candidates.begin(), candidates.end(), [&item](const Candidate &c) {
+            return c.item == item;
+        });
+    });
+
+    QList<WSurfaceItem *> chosen;
+    for (const auto &candidate : candidates) {
+        if (chosen.size() >= planeBudget())
+            break;
+        if (!m_rejected.contains(candidate.item))
+            chosen.append(candidate.item);
+    }
+
+    for (auto &plane : m_planes) {
+        if (!chosen.removeOne(plane.item.data()))
+            demote(plane);
+    }
+    m_planes.removeIf([](const Plane &plane) {
+        return !plane.item;
+    });
+    for (auto item : std::as_const(chosen))
+        promote(item);
+
+    updatePlaneCount();
+}
+
+QList<PlaneAssigner::Candidate> PlaneAssigner::findCandidates()
+{
+    QList<Candidate> candidates;
+    QList<WSurfaceItem *> items;
+
+    auto helper = Helper::instance();
+    // Mirrors copy the primary plane only
+    if (isEnabled() && planeBudget() > 0 && helper->currentMode() == Helper::CurrentMode::Normal
+        && helper->outputMode() != Helper::OutputMode::Copy && !m_output->directScanout()) {
+        const int workspace = helper->workspace()->current()->id();
+        const auto surfaces = m_output->surfaces();
+        for (auto wrapper : surfaces) {
+            if (wrapper->type() != SurfaceWrapper::Type::XdgToplevel
+                && wrapper->type() != SurfaceWrapper::Type::XWayland)
+                continue;
+            if (!wrapper->isVisible() || wrapper->isMinimized() || wrapper->isAnimationRunning()
+                || wrapper->blur() || !wrapper->showOnWorkspace(workspace) || !wrapper->surfaceItem())
+                continue;
+            collectItems(wrapper->surfaceItem(), &items);
+        }
+    }
+
+    QSet<WSurface *> watched;
+    for (auto item : std::as_const(items)) {
+        WSurface *surface = item->surface();
+        qw_buffer *buffer = surface ? ScanoutUtils::clientBuffer(surface) : nullptr;
+        wlr_dmabuf_attributes attribs;
+        if (!buffer || !buffer->get_dmabuf(&attribs))
+            continue;
+
+        // Static windows are never scored, so nothing is paid while no video plays
+        watched.insert(surface);
+        if (commitRate(surface) < MinimumCommitRate)
+            continue;
+
+        qreal value = score(item, attribs);
+        if (value <= 0)
+            continue;
+
+        const bool promoted = std::any_of(m_planes.begin(), m_planes.end(), [item](const Plane &p) {
+            return p.item == item;
+        });
+        if (promoted)
+            value *= PromotedBonus;
+        candidates.append({ item, value });
+    }
+
+    for (auto it = m_activity.begin(); it != m_activity.end();) {
+        if (watched.contains(it.key())) {
+            ++it;
+        } else {
+            QObject::disconnect(it->connection);
+            it = m_activity.erase(it);
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b) {
+        return a.score > b.score;
+    });
+    return candidates;
+}
+
+// Larger is better, zero when the item can not go on a plane at all
+qreal PlaneAssigner::score(WSurfaceItem *item, const wlr_dmabuf_attributes &attribs)
+{
+    const QRectF rect = item->mapRectToScene(item->boundingRect());
+    const QRectF outputRect = m_output->geometry();
+    if (rect.isEmpty() || !outputRect.contains(rect))
+        return 0;
+
+    const qreal area = rect.width() * rect.height() / (outputRect.width() * outputRect.height());
+    if (area < MinimumArea || !isUncovered(item, rect))
+        return 0;
+
+    qreal score = area;
+    // Composition would convert every frame to RGB in a shader pass
+    if (ScanoutUtils::isYuvFormat(attribs.format))
+        score *= 2;
+    WSurface *surface = item->surface();
+    if (!ScanoutUtils::isOpaque(surface, attribs.format))
+        score *= 0.5;
+
+    // Not every plane has a scaler, those surfaces are only tried when nothing better is around
+    wlr_surface *handle = surface->handle()->handle();
+    const qreal scale = m_output->output()->scale();
+    const bool unscaled = handle->current.transform == WL_OUTPUT_TRANSFORM_NORMAL
+        && !handle->current.viewport.has_src && !handle->current.viewport.has_dst
+        && qAbs(rect.width() * scale - attribs.width) < 1
+        && qAbs(rect.height() * scale - attribs.height) < 1;
+    if (!unscaled)
+        score *= 0.5;
+
+    return score;
+}
+
+qreal PlaneAssigner::commitRate(WSurface *surface)
+{
+    auto it = m_activity.find(surface);
+    if (it == m_activity.end()) {
+        it = m_activity.insert(surface, {});
+        it->connection = surface->handle()->safeConnect(&qw_surface::notify_commit, this, [this, surface] {
+            if (auto activity = m_activity.find(surface); activity != m_activity.end())
+                ++activity->commits;
+        });
+        it->timer.start();
+        return 0;
+    }
+
+    if (it->timer.elapsed() >= CommitRateWindow) {
+        it->rate = it->commits * 1000.0 / it->timer.restart();
+        it->commits = 0;
+    }
+    return it->rate;
+}
+
+bool PlaneAssigner::isUncovered(WSurfaceItem *item, const QRectF &rect)
+{
+    if (!m_sceneKeyChecked) {
+        m_sceneKeyChecked = true;
+        const size_t key = sceneKey();
+        if (key != m_sceneKey || !m_occlusionAge.isValid()
+            || m_occlusionAge.hasExpired(OcclusionMaxAge)) {
+            m_occlusion.clear();
+            m_sceneKey = key;
+            m_occlusionAge.start();
+        }
+    }
+
+    auto it = m_occlusion.constFind(item);
+    if (it != m_occlusion.constEnd() && it->rect == rect)
+        return it->uncovered;
+
+    const bool uncovered = ScanoutUtils::isUncovered(item, rect);
+    m_occlusion.insert(item, { rect, uncovered });
+    return uncovered;
+}
+
+// Changes whenever a window of the output moves, resizes, restacks or shows up
+size_t PlaneAssigner::sceneKey() const
+{
+    // Activating a window raises it
+    size_t key = qHash(Helper::instance()->activatedSurface());
+    const auto surfaces = m_output->surfaces();
+    for (auto surface : surfaces) {
+        if (!surface->isVisible())
+            continue;
+        const QRectF rect = surface->mapRectToScene(QRectF(QPointF(), surface->size()));
+        key = qHashMulti(key, surface, surface->z(), rect.x(), rect.y(), rect.width(), rect.height());
+    }
+    return key;
+}
+
+void PlaneAssigner::promote(WSurfaceItem *item)
+{
+    auto layer = qobject_cast<WOutputLayer *>(qmlAttachedPropertiesObject<WOutputLayer>(item));
+    if (!layer)
+        return;
+
+    layer->setOutputs({ m_output->screenViewport() });
+    layer->setEnabled(true);
+    m_planes.append({ item, layer });
+    qCDebug(qLcPlaneAssigner) << "Trying an overlay plane on" << m_output->output()->name()
+                              << "for" << item->surface();
+}
+
+void PlaneAssigner::demote(Plane &plane)
+{
+    if (plane.layer)
+        plane.layer->setEnabled(false);
+    plane.item = nullptr;
+    plane.layer = nullptr;
+}
+
+void PlaneAssigner::updatePlaneCount()
+{
+    const auto hardwareLayers = m_output->screenViewport()->hardwareLayers();
+    const int count = std::count_if(m_planes.begin(), m_planes.end(), [&hardwareLayers](const Plane &p) {
+        return hardwareLayers.contains(p.layer.data());
+    });
+    if (count == m_planeCount)
+        return;
+
+    m_planeCount = count;
+    Q_EMIT planeCountChanged();
+}
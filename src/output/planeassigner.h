@@ -0,0 +1,107 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wglobal.h>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QRectF>
+
+QT_BEGIN_NAMESPACE
+class QQuickItem;
+QT_END_NAMESPACE
+
+WAYLIB_SERVER_BEGIN_NAMESPACE
+class WOutputLayer;
+class WSurface;
+class WSurfaceItem;
+WAYLIB_SERVER_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+
+struct wlr_dmabuf_attributes;
+
+class Output;
+
+// Moves client surfaces that keep changing on their own, video above all, to
+// the overlay planes of an output. Each promoted surface is drawn on a waylib
+// output layer, so a new frame of it no longer recomposites the rest of the
+// output. Candidates are scored once per frame of the render window; whether a
+// plane can really show one is decided by the test commit of the backend, and
+// surfaces it refuses stay composited until they stop being candidates. The
+// cursor keeps its own plane and does not count against the budget.
+class PlaneAssigner : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PlaneAssigner(Output *output);
+    ~PlaneAssigner() override;
+
+    // Surfaces currently shown on an overlay plane
+    int planeCount() const;
+
+    // Disabled by setting TREELAND_DISABLE_OVERLAY_PLANES
+    static bool isEnabled();
+    // At most TREELAND_OVERLAY_PLANES surfaces are promoted per output, 2 by default
+    static int planeBudget();
+
+Q_SIGNALS:
+    void planeCountChanged();
+
+private:
+    struct Candidate
+    {
+        WSurfaceItem *item;
+        qreal score;
+    };
+
+    struct Plane
+    {
+        QPointer<WSurfaceItem> item;
+        QPointer<WOutputLayer> layer;
+        // Frames composited since the promotion without the backend taking it
+        int pendingFrames = 0;
+    };
+
+    struct Activity
+    {
+        QMetaObject::Connection connection;
+        QElapsedTimer timer;
+        int commits = 0;
+        qreal rate = 0;
+    };
+
+    struct Occlusion
+    {
+        QRectF rect;
+        bool uncovered;
+    };
+
+    void update();
+    QList<Candidate> findCandidates();
+    qreal score(WSurfaceItem *item, const wlr_dmabuf_attributes &attribs);
+    qreal commitRate(WSurface *surface);
+    bool isUncovered(WSurfaceItem *item, const QRectF &rect);
+    size_t sceneKey() const;
+    void promote(WSurfaceItem *item);
+    void demote(Plane &plane);
+    void updatePlaneCount();
+
+    Output *m_output;
+    QList<Plane> m_planes;
+    // Refused by the backend, composited until they stop being candidates
+    QList<QPointer<WSurfaceItem>> m_rejected;
+    QHash<WSurface *, Activity> m_activity;
+    // Results of ScanoutUtils::isUncovered, walking the scene is the costly
+    // part of scoring. Dropped when the windows of the output move, restack or
+    // change visibility, and after a while for overlays that are no windows.
+    QHash<WSurfaceItem *, Occlusion> m_occlusion;
+    size_t m_sceneKey = 0;
+    bool m_sceneKeyChecked = false;
+    QElapsedTimer m_occlusionAge;
+    int m_planeCount = 0;
+};
@@ -0,0 +1,115 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/scanoututils.h"
+
+#include <woutputviewport.h>
+#include <wquickcursor.h>
+#include <wsurface.h>
+
+#include <qwbuffer.h>
+#include <qwcompositor.h>
+
+#include <QQuickItem>
+
+#include <drm_fourcc.h>
+
+namespace {
+// Whether anything visible is painted inside rect (scene coordinates) by item
+// or its children. Hardware cursors live on their own plane and do not count.
+bool paintsInside(QQuickItem *item, const QRectF &rect)
+{
+    if (!item->isVisible() || qFuzzyIsNull(item->opacity()) || qobject_cast<WQuickCursor *>(item)
+        || qobject_cast<WOutputViewport *>(item))
+        return false;
+
+    if (item->flags().testFlag(QQuickItem::ItemHasContents)
+        && item->mapRectToScene(item->boundingRect()).intersects(rect))
+        return true;
+
+    const auto children = item->childItems();
+    for (auto child : children) {
+        if (paintsInside(child, rect))
+            return true;
+    }
+    return false;
+}
+} // namespace
+
+namespace ScanoutUtils {
+bool isOpaqueFormat(uint32_t format)
+{
+    switch (format) {
+    case DRM_FORMAT_XRGB8888:
+    case DRM_FORMAT_XBGR8888:
+    case DRM_FORMAT_RGBX8888:
+    case DRM_FORMAT_BGRX8888:
+    case DRM_FORMAT_XRGB2101010:
+    case DRM_FORMAT_XBGR2101010:
+    case DRM_FORMAT_RGB565:
+    case DRM_FORMAT_RGB888:
+    case DRM_FORMAT_BGR888:
+        return true;
+    default:
+        return isYuvFormat(format);
+    }
+}
+
+bool isYuvFormat(uint32_t format)
+{
+    switch (format) {
+    case DRM_FORMAT_NV12:
+    case DRM_FORMAT_NV21:
+    case DRM_FORMAT_NV16:
+    case DRM_FORMAT_P010:
+    case DRM_FORMAT_P012:
+    case DRM_FORMAT_P016:
+    case DRM_FORMAT_YUV420:
+    case DRM_FORMAT_YVU420:
+    case DRM_FORMAT_YUYV:
+    case DRM_FORMAT_UYVY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+qw_buffer *clientBuffer(WSurface *surface)
+{
+    qw_buffer *buffer = surface->buffer();
+    if (!buffer)
+        return nullptr;
+    if (auto client = wlr_client_buffer_get(*buffer); client && client->source)
+        return qw_buffer::from(client->source);
+    return buffer;
+}
+
+bool isOpaque(WSurface *surface, uint32_t format)
+{
+    if (isOpaqueFormat(format))
+        return true;
+
+    wlr_surface *handle = surface->handle()->handle();
+    pixman_box32_t box = { 0, 0, handle->current.width, handle->current.height };
+    return pixman_region32_contains_rectangle(&handle->opaque_region, &box) == PIXMAN_REGION_IN;
+}
+
+bool isUncovered(QQuickItem *item, const QRectF &rect)
+{
+    for (QQuickItem *child = item; auto parent = child->parentItem(); child = parent) {
+        if (!qFuzzyCompare(child->opacity(), 1) || !qFuzzyCompare(child->scale(), 1)
+            || !qFuzzyIsNull(child->rotation()))
+            return false;
+
+        auto siblings = parent->childItems();
+        std::stable_sort(siblings.begin(), siblings.end(), [](QQuickItem *a, QQuickItem *b) {
+            return a->z() < b->z();
+        });
+        for (auto it = siblings.rbegin(); *it != child; ++it) {
+            if (paintsInside(*it, rect))
+                return false;
+        }
+    }
+    return true;
+}
+} // namespace ScanoutUtils
@@ -0,0 +1,39 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wglobal.h>
+
+#include <QRectF>
+
+#include <cstdint>
+
+QT_BEGIN_NAMESPACE
+class QQuickItem;
+QT_END_NAMESPACE
+
+WAYLIB_SERVER_BEGIN_NAMESPACE
+class WSurface;
+WAYLIB_SERVER_END_NAMESPACE
+
+QW_BEGIN_NAMESPACE
+class qw_buffer;
+QW_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+QW_USE_NAMESPACE
+
+// Checks shared by the ways of putting client buffers on hardware planes
+namespace ScanoutUtils {
+// DRM formats without an alpha channel
+bool isOpaqueFormat(uint32_t format);
+// DRM formats produced by video decoders
+bool isYuvFormat(uint32_t format);
+// Like the capture module, prefer the client's own buffer over its texture wrapper
+qw_buffer *clientBuffer(WSurface *surface);
+// Whether the whole current buffer of surface is opaque, by its format or its opaque region
+bool isOpaque(WSurface *surface, uint32_t format);
+// Whether item reaches the screen untouched, and nothing is painted over it
+// inside rect (scene coordinates)
+bool isUncovered(QQuickItem *item, const QRectF &rect);
+} // namespace ScanoutUtils
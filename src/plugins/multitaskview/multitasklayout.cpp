@@ -0,0 +1,164 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "multitasklayout.h"
+
+#include <algorithm>
+#include <cmath>
+
+void MultitaskLayout::setOptions(const Options &options)
+{
+    if (m_options == options)
+        return;
+    m_options = options;
+    invalidate();
+}
+
+const MultitaskLayout::Options &MultitaskLayout::options() const
+{
+    return m_options;
+}
+
+bool MultitaskLayout::layout(const QList<QSizeF> &sizes)
+{
+    if (m_options.availWidth <= 0)
+        return false;
+
+    const auto mismatch = std::mismatch(sizes.cbegin(), sizes.cend(), m_sizes.cbegin(), m_sizes.cend());
+    const int firstChanged = std::distance(sizes.cbegin(), mismatch.first);
+    if (m_step >= 0 && firstChanged == sizes.size() && sizes.size() == m_sizes.size())
+        return true;
+
+    // A small change mostly keeps the row height, check the last step before searching
+    int step = -1;
+    if (m_step >= 0 && fits(sizes, m_step) && (m_step == 0 || !fits(sizes, m_step - 1)))
+        step = m_step;
+
+    if (step < 0) {
+        // The last step (minRowHeight, overlapping) always fits
+        int low = 0;
+        int high = stepCount();
+        while (low < high) {
+            const int middle = low + (high - low) / 2;
+            if (fits(sizes, middle))
+                high = middle;
+            else
+                low = middle + 1;
+        }
+        step = low;
+    }
+
+    const bool keepRows = step == m_step;
+    m_step = step;
+    m_sizes = sizes;
+    flow(keepRows ? firstChanged : 0);
+    return true;
+}
+
+void MultitaskLayout::invalidate()
+{
+    m_step = -1;
+    m_sizes.clear();
+    m_cells.clear();
+    m_rowStarts.clear();
+}
+
+qreal MultitaskLayout::rowHeight() const
+{
+    return m_step >= 0 ? stepHeight(m_step) : 0;
+}
+
+const QList<MultitaskLayout::Cell> &MultitaskLayout::cells() const
+{
+    return m_cells;
+}
+
+const QList<int> &MultitaskLayout::rowStarts() const
+{
+    return m_rowStarts;
+}
+
+int MultitaskLayout::stepCount() const
+{
+    const qreal range = m_options.maxRowHeight - m_options.minRowHeight;
+    if (range <= 0 || m_options.rowHeightStep <= 0)
+        return 0;
+    return static_cast<int>(std::ceil(range / m_options.rowHeightStep));
+}
+
+qreal MultitaskLayout::stepHeight(int step) const
+{
+    if (step >= stepCount())
+        return m_options.minRowHeight;
+    return m_options.maxRowHeight - step * m_options.rowHeightStep;
+}
+
+qreal MultitaskLayout::cellWidth(const QSizeF &size, qreal rowH) const
+{
+    const qreal padding = m_options.cellPadding;
+    const qreal whRatio = size.width() / size.height();
+    return std::min(m_options.availWidth,
+                    whRatio * std::min(rowH - 2 * padding, size.height()) + 2 * padding);
+}
+
+bool MultitaskLayout::fits(const QList<QSizeF> &sizes, int step) const
+{
+    if (step >= stepCount())
+        return true;
+
+    const qreal rowH = stepHeight(step);
+    const qreal availWidth = m_options.availWidth;
+    int rows = 1;
+    qreal acc = 0;
+    for (const auto &size : sizes) {
+        const qreal width = cellWidth(size, rowH);
+        const qreal newAcc = acc + width;
+        if (newAcc <= availWidth || newAcc / availWidth <= m_options.loadFactor) {
+            acc = newAcc;
+        } else {
+            acc = width;
+            // No need to flow the rest once the rows are too high
+            if (++rows * rowH > m_options.availHeight)
+                return false;
+        }
+    }
+    return rows * rowH <= m_options.availHeight;
+}
+
+void MultitaskLayout::flow(int fromIndex)
+{
+    const qreal rowH = stepHeight(m_step);
+    const qreal availWidth = m_options.availWidth;
+    const qreal padding = m_options.cellPadding;
+
+    // Rows before the one with the cell ahead of the first changed cell stay as they
+    // are, that row may take the changed cell if it now fits
+    const auto row = std::upper_bound(m_rowStarts.cbegin(), m_rowStarts.cend(), fromIndex - 1);
+    const qsizetype keptRows = std::max<qsizetype>(0, std::distance(m_rowStarts.cbegin(), row) - 1);
+    const int start = keptRows < m_rowStarts.size() ? m_rowStarts.at(keptRows) : 0;
+    m_rowStarts.resize(keptRows);
+    m_cells.resize(m_sizes.size());
+    if (start < m_sizes.size())
+        m_rowStarts.append(start);
+
+    qreal acc = 0;
+    for (int i = start; i < m_sizes.size(); ++i) {
+        const auto &size = m_sizes.at(i);
+        auto &cell = m_cells[i];
+        qreal width = cellWidth(size, rowH);
+        cell.padding = size.height() < rowH - 2 * padding;
+
+        const qreal newAcc = acc + width;
+        if (newAcc <= availWidth) {
+            acc = newAcc;
+        } else if (newAcc / availWidth > m_options.loadFactor) {
+            acc = width;
+            m_rowStarts.append(i);
+        } else {
+            // Just scale the last element
+            width = availWidth - acc;
+            acc = newAcc;
+        }
+        cell.width = width - 2 * padding;
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QList>
+#include <QSizeF>
+
+// Flows windows into rows of equal height, keeping their order and aspect ratio.
+// The row height is the largest step below maxRowHeight whose rows fit into the
+// available height, minRowHeight is used (overlapping) if none fits. The step is
+// found by binary search and the last solution is kept, so a change that keeps
+// the row height only re-flows the rows from the first changed window on.
+class MultitaskLayout
+{
+public:
+    struct Options
+    {
+        qreal availWidth = 0;
+        qreal availHeight = 0;
+        qreal cellPadding = 0;
+        qreal loadFactor = 1;
+        qreal maxRowHeight = 0;
+        qreal minRowHeight = 0;
+        qreal rowHeightStep = 1;
+
+        bool operator==(const Options &other) const = default;
+    };
+
+    struct Cell
+    {
+        // without the cell padding
+        qreal width = 0;
+        bool padding = false;
+    };
+
+    void setOptions(const Options &options);
+    const Options &options() const;
+
+    // Returns false if there is no width to layout in
+    bool layout(const QList<QSizeF> &sizes);
+    void invalidate();
+
+    qreal rowHeight() const;
+    const QList<Cell> &cells() const;
+    // Index of the first cell of each row
+    const QList<int> &rowStarts() const;
+
+private:
+    int stepCount() const;
+    qreal stepHeight(int step) const;
+    qreal cellWidth(const QSizeF &size, qreal rowH) const;
+    bool fits(const QList<QSizeF> &sizes, int step) const;
+    void flow(int fromIndex);
+
+    Options m_options;
+    QList<QSizeF> m_sizes;
+    QList<Cell> m_cells;
+    QList<int> m_rowStarts;
+    int m_step = -1;
+};
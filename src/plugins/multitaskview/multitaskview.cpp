@@ -12,8 +12,6 @@
 #include <woutputitem.h>
 #include <woutputrenderwindow.h>
 
-#include <QtConcurrentMap>
-
 WAYLIB_SERVER_USE_NAMESPACE
 
 Multitaskview::Multitaskview(QQuickItem *parent)
@@ -124,6 +122,11 @@ void MultitaskviewSurfaceModel::initializeModel()
                 this,
                 &MultitaskviewSurfaceModel::handleSurfaceStateChanged,
                 Qt::UniqueConnection);
+        connect(surface,
+                &SurfaceWrapper::appIdChanged,
+                this,
+                &MultitaskviewSurfaceModel::updateAppIdIndex,
+                Qt::UniqueConnection);
     }
     std::sort(m_data.begin(),
               m_data.end(),
@@ -131,6 +134,7 @@ void MultitaskviewSurfaceModel::initializeModel()
                   return laterActiveThan(lhs->wrapper, rhs->wrapper);
               });
     doUpdateZOrder(m_data);
+    updateAppIdIndex();
     endResetModel();
     m_modelReady = true;
     Q_EMIT countChanged();
@@ -220,36 +224,12 @@ void MultitaskviewSurfaceModel::updateZOrder()
 
 int MultitaskviewSurfaceModel::prevSameAppIndex(int index)
 {
-    if (index < 0 || index >= count())
-        return -1;
-    auto circularPrev = [this](int i) {
-        return (i + count() - 1) % count();
-    };
-    auto i = circularPrev(index);
-    for (; i != index; i = circularPrev(i)) {
-        if (m_data[i]->wrapper->shellSurface()->appId()
-            == m_data[index]->wrapper->shellSurface()->appId()) {
-            break;
-        }
-    }
-    return i;
+    return m_appIdIndex.prev(index);
 }
 
 int MultitaskviewSurfaceModel::nextSameAppIndex(int index)
 {
-    if (index < 0 || index >= count())
-        return -1;
-    auto circularNext = [this](int i) {
-        return (i + 1) % count();
-    };
-    auto i = circularNext(index);
-    for (; i != index; i = circularNext(i)) {
-        if (m_data[i]->wrapper->shellSurface()->appId()
-            == m_data[index]->wrapper->shellSurface()->appId()) {
-            break;
-        }
-    }
-    return i;
+    return m_appIdIndex.next(index);
 }
 
 QRectF MultitaskviewSurfaceModel::layoutArea() const
@@ -266,12 +246,8 @@ void MultitaskviewSurfaceModel::setLayoutArea(const QRectF &newLayoutArea)
     emit layoutAreaChanged();
 }
 
-bool MultitaskviewSurfaceModel::tryLayout(const QList<ModelDataPtr> &rawData,
-                                          qreal rowH,
-                                          bool ignoreOverlap)
+void MultitaskviewSurfaceModel::calcDisplayPos(const QList<ModelDataPtr> &rawData)
 {
-    int nrows = 1;
-    qreal acc = 0;
     auto devicePixelRatio = output()->outputItem()->devicePixelRatio();
     auto topContentMargin =
         TreelandConfig::ref().multitaskviewTopContentMargin() / devicePixelRatio;
@@ -283,111 +259,72 @@ bool MultitaskviewSurfaceModel::tryLayout(const QList<ModelDataPtr> &rawData,
     auto availWidth = std::max(0.0, layoutArea().width() - 2 * horizontalMargin);
     auto availHeight =
         std::max(0.0, layoutArea().height() - topContentMargin - bottomContentMargin);
-    if (availWidth <= 0)
-        return false;
-    QList<QList<ModelDataPtr>> rowstmp;
-    QList<ModelDataPtr> currow;
-    for (auto &modelData : rawData) {
-        auto surface = modelData->wrapper;
-        auto whRatio = surface->width() / surface->height();
-        modelData->pendingPadding = surface->height() < (rowH - 2 * cellPadding);
-        auto curW = std::min(availWidth,
-                             whRatio * std::min(rowH - 2 * cellPadding, surface->height())
-                                 + 2 * cellPadding);
-        modelData->pendingGeometry.setWidth(curW - 2 * cellPadding);
-        auto newAcc = acc + curW;
-        if (newAcc <= availWidth) {
-            acc = newAcc;
-            currow.append(modelData);
-        } else if (newAcc / availWidth > TreelandConfig::ref().multitaskviewLoadFactor()) {
-            acc = curW;
-            nrows++;
-            rowstmp.append(currow);
-            currow = { modelData };
-        } else {
-            // Just scale the last element
-            curW = availWidth - acc;
-            modelData->pendingGeometry.setWidth(curW - 2 * cellPadding);
-            currow.append(modelData);
-            acc = newAcc;
-        }
-    }
-    if (nrows * rowH <= availHeight || ignoreOverlap) {
-        if (currow.length()) {
-            rowstmp.append(currow);
+    const auto &rowStarts = m_layout.rowStarts();
+    const auto &cells = m_layout.cells();
+    const auto rowHeight = m_layout.rowHeight();
+    auto contentHeight = rowStarts.size() * rowHeight;
+    auto curY = std::max(availHeight - contentHeight, 0.0) / 2 + topContentMargin;
+    const auto hCenter = availWidth / 2;
+    // Rows are continuous ranges of rawData
+    auto rowRange = [&rowStarts, &rawData](qsizetype row) {
+        const int end = row + 1 < rowStarts.size() ? rowStarts[row + 1] : rawData.size();
+        return std::make_pair(rowStarts[row], end);
+    };
+    for (qsizetype i = 0; i < rowStarts.size(); ++i) {
+        const auto [begin, end] = rowRange(i);
+        const int count = end - begin;
+        qreal totW = 0;
+        for (int k = begin; k < end; ++k)
+            totW += cells[k].width + 2 * cellPadding;
+        const auto [lastRowBegin, lastRowEnd] = rowRange(std::max<qsizetype>(0, i - 1));
+        const auto [nextRowBegin, nextRowEnd] = rowRange(std::min(rowStarts.size() - 1, i + 1));
+        auto curX = hCenter - totW / 2 + cellPadding + horizontalMargin;
+        for (auto j = 0; j < count; ++j) {
+            auto window = rawData[begin + j];
+            const auto &cell = cells[begin + j];
+            window->pendingPadding = cell.padding;
+            window->pendingGeometry = QRectF(curX, curY, cell.width, rowHeight - 2 * cellPadding);
+            window->pendingLeftIndex = begin + (j - 1 + count) % count;
+            window->pendingRightIndex = begin + (j + 1) % count;
+            window->pendingUpIndex = lastRowBegin + std::min(lastRowEnd - lastRowBegin - 1, j);
+            window->pendingDownIndex = nextRowBegin + std::min(nextRowEnd - nextRowBegin - 1, j);
+            curX += cell.width + 2 * cellPadding;
         }
-        m_rowHeight = rowH;
-        m_rows = rowstmp;
-        return true;
+        curY += rowHeight;
     }
-    return false;
+    m_contentHeight = curY;
 }
 
-void MultitaskviewSurfaceModel::calcDisplayPos(const QList<ModelDataPtr> &rawData)
+void MultitaskviewSurfaceModel::doCalculateLayout(const QList<ModelDataPtr> &rawData)
 {
     auto devicePixelRatio = output()->outputItem()->devicePixelRatio();
     auto topContentMargin =
         TreelandConfig::ref().multitaskviewTopContentMargin() / devicePixelRatio;
     auto bottomContentMargin =
         TreelandConfig::ref().multitaskviewBottomContentMargin() / devicePixelRatio;
-    auto cellPadding = TreelandConfig::ref().multitaskviewCellPadding() / devicePixelRatio;
     auto horizontalMargin =
         TreelandConfig::ref().multitaskviewHorizontalMargin() / devicePixelRatio;
-    auto availWidth = std::max(0.0, layoutArea().width() - 2 * horizontalMargin);
-    auto availHeight =
-        std::max(0.0, layoutArea().height() - topContentMargin - bottomContentMargin);
-    auto contentHeight = m_rows.length() * m_rowHeight;
-    auto curY = std::max(availHeight - contentHeight, 0.0) / 2 + topContentMargin;
-    const auto hCenter = availWidth / 2;
-    for (auto i = 0; i < m_rows.size(); ++i) {
-        auto row = m_rows[i];
-        const auto totW = QtConcurrent::blockingMappedReduced(
-            row,
-            [cellPadding](ModelDataPtr data) {
-                return data->pendingGeometry.width() + 2 * cellPadding;
-            },
-            [](qreal &acc, const qreal &cur) {
-                acc += cur;
-            });
-        auto curX = hCenter - totW / 2 + cellPadding + horizontalMargin;
-        for (auto j = 0; j < row.size(); ++j) {
-            auto window = row[j];
-            window->pendingGeometry.moveLeft(curX);
-            window->pendingGeometry.moveTop(curY);
-            window->pendingGeometry.setHeight(m_rowHeight - 2 * cellPadding);
-            window->pendingLeftIndex = rawData.indexOf(row[(j - 1 + row.size()) % row.size()]);
-            window->pendingRightIndex = rawData.indexOf(row[(j + 1) % row.size()]);
-            auto lastRow = m_rows[std::max(0, i - 1)];
-            auto lastRowIndex = std::min(static_cast<int>(lastRow.size()) - 1, j);
-            window->pendingUpIndex = rawData.indexOf(lastRow[lastRowIndex]);
-            auto nextRow = m_rows[std::min(static_cast<int>(m_rows.size()) - 1, i + 1)];
-            auto nextRowIndex = std::min(static_cast<int>(nextRow.size()) - 1, j);
-            window->pendingDownIndex = rawData.indexOf(nextRow[nextRowIndex]);
-            curX += window->pendingGeometry.width() + 2 * cellPadding;
-        }
-        curY += m_rowHeight;
-    }
-    m_contentHeight = curY;
-}
 
-void MultitaskviewSurfaceModel::doCalculateLayout(const QList<ModelDataPtr> &rawData)
-{
-    auto devicePixelRatio = output()->outputItem()->devicePixelRatio();
-    auto maxWindowHeight =
+    MultitaskLayout::Options options;
+    options.availWidth = std::max(0.0, layoutArea().width() - 2 * horizontalMargin);
+    options.availHeight =
+        std::max(0.0, layoutArea().height() - topContentMargin - bottomContentMargin);
+    options.cellPadding = TreelandConfig::ref().multitaskviewCellPadding() / devicePixelRatio;
+    options.loadFactor = TreelandConfig::ref().multitaskviewLoadFactor();
+    options.maxRowHeight =
         std::min(layoutArea().height(),
                  static_cast<qreal>(TreelandConfig::ref().normalWindowHeight() / devicePixelRatio));
-    auto minWindowHeight = TreelandConfig::ref().minMultitaskviewSurfaceHeight() / devicePixelRatio;
-    auto windowHeightStep = TreelandConfig::ref().windowHeightStep() / devicePixelRatio;
-    auto rowH = maxWindowHeight;
-    while (rowH > minWindowHeight) {
-        if (tryLayout(rawData, rowH)) {
-            break;
-        }
-        rowH -= windowHeightStep;
-    }
-    if (rowH < minWindowHeight) {
-        tryLayout(rawData, minWindowHeight, true);
-    }
+    options.minRowHeight = TreelandConfig::ref().minMultitaskviewSurfaceHeight() / devicePixelRatio;
+    options.rowHeightStep = TreelandConfig::ref().windowHeightStep() / devicePixelRatio;
+    m_layout.setOptions(options);
+
+    QList<QSizeF> sizes;
+    sizes.reserve(rawData.size());
+    for (const auto &modelData : rawData)
+        sizes.append(modelData->wrapper->size());
+    if (!m_layout.layout(sizes))
+        return;
+
     calcDisplayPos(rawData);
 }
 
@@ -488,6 +425,15 @@ void MultitaskviewSurfaceModel::handleSurfaceMappedChanged()
     }
 }
 
+void MultitaskviewSurfaceModel::updateAppIdIndex()
+{
+    QList<SurfaceWrapper *> surfaces;
+    surfaces.reserve(m_data.size());
+    for (const auto &modelData : std::as_const(m_data))
+        surfaces.append(modelData->wrapper);
+    m_appIdIndex.setSurfaces(surfaces);
+}
+
 void MultitaskviewSurfaceModel::handleSurfaceAdded(SurfaceWrapper *surface)
 {
     if (!Helper::instance()->surfaceBelongsToCurrentUser(surface))
@@ -502,6 +448,11 @@ void MultitaskviewSurfaceModel::handleSurfaceAdded(SurfaceWrapper *surface)
             this,
             &MultitaskviewSurfaceModel::handleSurfaceStateChanged,
             Qt::UniqueConnection);
+    connect(surface,
+            &SurfaceWrapper::appIdChanged,
+            this,
+            &MultitaskviewSurfaceModel::updateAppIdIndex,
+            Qt::UniqueConnection);
     if (surface->ownsOutput() == output()) {
         if (surfaceReady(surface)) {
             addReadySurface(surface);
@@ -530,6 +481,11 @@ void MultitaskviewSurfaceModel::handleSurfaceRemoved(SurfaceWrapper *surface)
                &SurfaceWrapper::surfaceStateChanged,
                this,
                &MultitaskviewSurfaceModel::handleSurfaceStateChanged);
+    disconnect(surface,
+               &SurfaceWrapper::appIdChanged,
+               this,
+               &MultitaskviewSurfaceModel::updateAppIdIndex);
+    updateAppIdIndex();
     endRemoveRows();
     doCalculateLayout(m_data);
     auto [beginIndex, endIndex] = commitAndGetUpdateRange(m_data);
@@ -597,6 +553,7 @@ void MultitaskviewSurfaceModel::addReadySurface(SurfaceWrapper *surface)
     beginInsertRows({}, insertedIndex, insertedIndex);
     m_data = pendingData;
     pendingData.clear();
+    updateAppIdIndex();
     endInsertRows();
     Q_EMIT rowsChanged();
     Q_EMIT countChanged();
@@ -639,13 +596,7 @@ QRectF MultitaskviewSurfaceModel::surfaceGeometry(SurfaceWrapper *surface)
 
 bool MultitaskviewSurfaceModel::laterActiveThan(SurfaceWrapper *a, SurfaceWrapper *b)
 {
-    auto activeIndex = [this](SurfaceWrapper *surface) {
-        auto it = std::find(workspace()->m_activedSurfaceHistory.begin(),
-                            workspace()->m_activedSurfaceHistory.end(),
-                            surface);
-        return std::distance(workspace()->m_activedSurfaceHistory.begin(), it);
-    };
-    return activeIndex(a) < activeIndex(b);
+    return workspace()->activationStamp(a) > workspace()->activationStamp(b);
 }
 
 void MultitaskviewSurfaceModel::connectWorkspace(WorkspaceModel *workspace)
@@ -674,7 +625,7 @@ void MultitaskviewSurfaceModel::disconnectWorkspace(WorkspaceModel *workspace)
 
 uint MultitaskviewSurfaceModel::rows() const
 {
-    return m_rows.count();
+    return m_layout.rowStarts().size();
 }
 
 WorkspaceModel *MultitaskviewSurfaceModel::workspace() const
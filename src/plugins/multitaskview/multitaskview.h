@@ -3,6 +3,8 @@
 #pragma once
 
 #include "interfaces/multitaskviewinterface.h"
+#include "multitasklayout.h"
+#include "surface/appidindex.h"
 
 #include <QAbstractListModel>
 #include <QQuickItem>
@@ -169,7 +171,6 @@ Q_SIGNALS:
     void countChanged();
 
 private:
-    bool tryLayout(const QList<ModelDataPtr> &rawData, qreal rowH, bool ignoreOverlap = false);
     void calcDisplayPos(const QList<ModelDataPtr> &rawData);
     void doCalculateLayout(const QList<ModelDataPtr> &rawData);
     void doUpdateZOrder(const QList<ModelDataPtr> &rawData);
@@ -178,6 +179,7 @@ private:
     void handleWrapperOutputChanged();
     void handleSurfaceStateChanged();
     void handleSurfaceMappedChanged();
+    void updateAppIdIndex();
     void handleSurfaceAdded(SurfaceWrapper *surface);
     void handleSurfaceRemoved(SurfaceWrapper *surface);
     void addReadySurface(SurfaceWrapper *surface);
@@ -190,8 +192,8 @@ private:
 
     QList<ModelDataPtr> m_data{};
     QRectF m_layoutArea{};
-    QList<QList<ModelDataPtr>> m_rows{};
-    qreal m_rowHeight{ 0 };
+    MultitaskLayout m_layout;
+    AppIdIndex m_appIdIndex;
     qreal m_contentHeight{ 0 };
     bool m_modelReady;
     QList<ModelDataPtr> m_toBeInserted;
@@ -257,11 +257,11 @@ Item {
                     }
 
                     property bool highlighted: dragManager.item === null && activeFocus && surfaceItemDelegate.state === "taskview"
-                    SurfaceProxy {
-                        id: surfaceProxy
+                    SurfaceThumbnail {
+                        id: surfaceThumbnail
                         surface: surfaceItemDelegate.wrapper
-                        live: true
-                        fullProxy: true
+                        fullResolution: surfaceItemDelegate.hovered || surfaceItemDelegate.highlighted
+                                        || surfaceItemDelegate.state !== "taskview"
                         radius: delegateCornerRadius
                         width: parent.width
                         height: width / surfaceItemDelegate.ratio
@@ -0,0 +1,193 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "surfacethumbnail.h"
+
+#include "surface/surfaceproxy.h"
+#include "surface/surfacewrapper.h"
+
+#include <wsurface.h>
+
+#include <qwcompositor.h>
+
+#include <QQuickWindow>
+#include <QTimer>
+
+#include <private/qquickshadereffectsource_p.h>
+
+WAYLIB_SERVER_USE_NAMESPACE
+QW_USE_NAMESPACE
+
+SurfaceThumbnail::SurfaceThumbnail(QQuickItem *parent)
+    : QQuickItem(parent)
+    , m_proxy(new SurfaceProxy(this))
+    , m_texture(new QQuickShaderEffectSource(this))
+    , m_updateTimer(new QTimer(this))
+    , m_fullResolution(false)
+    , m_dirty(false)
+{
+    m_proxy->setFullProxy(true);
+
+    m_texture->setSourceItem(m_proxy);
+    m_texture->setLive(false);
+    m_texture->setMipmap(true);
+    m_texture->setSmooth(true);
+
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(1000 / m_maxFrameRate);
+    connect(m_updateTimer, &QTimer::timeout, this, &SurfaceThumbnail::onUpdateTimeout);
+
+    updateMode();
+}
+
+SurfaceThumbnail::~SurfaceThumbnail()
+{
+    QObject::disconnect(m_commitConnection);
+}
+
+SurfaceWrapper *SurfaceThumbnail::surface() const
+{
+    return m_surface;
+}
+
+void SurfaceThumbnail::setSurface(SurfaceWrapper *newSurface)
+{
+    if (m_surface == newSurface)
+        return;
+
+    if (m_surface)
+        m_surface->disconnect(this);
+    QObject::disconnect(m_commitConnection);
+
+    m_surface = newSurface;
+    m_proxy->setSurface(newSurface);
+
+    if (m_surface) {
+        connect(m_surface, &SurfaceWrapper::destroyed, this, [this] {
+            setSurface(nullptr);
+        });
+        if (auto wsurface = m_surface->surface()) {
+            m_commitConnection = wsurface->handle()->safeConnect(&qw_surface::notify_commit,
+                                                                 this,
+                                                                 &SurfaceThumbnail::onCommitted);
+        }
+        scheduleTextureUpdate();
+    }
+
+    Q_EMIT surfaceChanged();
+}
+
+qreal SurfaceThumbnail::radius() const
+{
+    return m_proxy->radius();
+}
+
+void SurfaceThumbnail::setRadius(qreal newRadius)
+{
+    if (qFuzzyCompare(m_proxy->radius(), newRadius))
+        return;
+    m_proxy->setRadius(newRadius);
+    Q_EMIT radiusChanged();
+}
+
+bool SurfaceThumbnail::fullResolution() const
+{
+    return m_fullResolution;
+}
+
+void SurfaceThumbnail::setFullResolution(bool newFullResolution)
+{
+    if (m_fullResolution == newFullResolution)
+        return;
+    m_fullResolution = newFullResolution;
+    updateMode();
+    Q_EMIT fullResolutionChanged();
+}
+
+int SurfaceThumbnail::maxFrameRate() const
+{
+    return m_maxFrameRate;
+}
+
+void SurfaceThumbnail::setMaxFrameRate(int newMaxFrameRate)
+{
+    newMaxFrameRate = qMax(1, newMaxFrameRate);
+    if (m_maxFrameRate == newMaxFrameRate)
+        return;
+    m_maxFrameRate = newMaxFrameRate;
+    m_updateTimer->setInterval(1000 / m_maxFrameRate);
+    Q_EMIT maxFrameRateChanged();
+}
+
+void SurfaceThumbnail::geometryChange(const QRectF &newGeo, const QRectF &oldGeo)
+{
+    QQuickItem::geometryChange(newGeo, oldGeo);
+
+    m_proxy->setSize(newGeo.size());
+    m_texture->setSize(newGeo.size());
+    if (newGeo.size() != oldGeo.size())
+        updateTextureSize();
+}
+
+void SurfaceThumbnail::itemChange(ItemChange change, const ItemChangeData &data)
+{
+    QQuickItem::itemChange(change, data);
+
+    if (change == ItemDevicePixelRatioHasChanged || change == ItemSceneChange)
+        updateTextureSize();
+}
+
+void SurfaceThumbnail::onCommitted()
+{
+    if (m_fullResolution)
+        return;
+
+    if (m_updateTimer->isActive()) {
+        m_dirty = true;
+        return;
+    }
+
+    scheduleTextureUpdate();
+}
+
+void SurfaceThumbnail::onUpdateTimeout()
+{
+    if (!m_dirty || m_fullResolution)
+        return;
+    scheduleTextureUpdate();
+}
+
+void SurfaceThumbnail::scheduleTextureUpdate()
+{
+    m_dirty = false;
+    m_texture->scheduleUpdate();
+    m_updateTimer->start();
+}
+
+void SurfaceThumbnail::updateTextureSize()
+{
+    const qreal dpr = window() ? window()->effectiveDevicePixelRatio() : 1.0;
+    m_texture->setTextureSize((size() * dpr).toSize());
+    if (m_fullResolution)
+        return;
+    // The old texture is stretched until the timer updates it, so a resize
+    // animation renders at the capped rate too
+    m_dirty = true;
+    if (!m_updateTimer->isActive())
+        m_updateTimer->start();
+}
+
+void SurfaceThumbnail::updateMode()
+{
+    // The proxy is only rendered into the texture while it is hidden by the
+    // effect source, which also keeps the client's frame callbacks at the capped rate
+    m_texture->setVisible(!m_fullResolution);
+    m_texture->setHideSource(!m_fullResolution);
+
+    if (m_fullResolution) {
+        m_updateTimer->stop();
+        m_dirty = false;
+    } else {
+        scheduleTextureUpdate();
+    }
+}
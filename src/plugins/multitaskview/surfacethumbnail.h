@@ -0,0 +1,67 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QQuickItem>
+Q_MOC_INCLUDE("surface/surfacewrapper.h")
+
+QT_BEGIN_NAMESPACE
+class QQuickShaderEffectSource;
+class QTimer;
+QT_END_NAMESPACE
+
+class SurfaceProxy;
+class SurfaceWrapper;
+
+// Shows a window of the multitask view through a mipmapped texture at the item's
+// size, refreshed from client commits at most maxFrameRate times per second.
+// With fullResolution the surface is drawn live instead.
+class SurfaceThumbnail : public QQuickItem
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(SurfaceWrapper* surface READ surface WRITE setSurface NOTIFY surfaceChanged FINAL)
+    Q_PROPERTY(qreal radius READ radius WRITE setRadius NOTIFY radiusChanged FINAL)
+    Q_PROPERTY(bool fullResolution READ fullResolution WRITE setFullResolution NOTIFY fullResolutionChanged FINAL)
+    Q_PROPERTY(int maxFrameRate READ maxFrameRate WRITE setMaxFrameRate NOTIFY maxFrameRateChanged FINAL)
+
+public:
+    explicit SurfaceThumbnail(QQuickItem *parent = nullptr);
+    ~SurfaceThumbnail() override;
+
+    SurfaceWrapper *surface() const;
+    void setSurface(SurfaceWrapper *newSurface);
+
+    qreal radius() const;
+    void setRadius(qreal newRadius);
+
+    bool fullResolution() const;
+    void setFullResolution(bool newFullResolution);
+
+    int maxFrameRate() const;
+    void setMaxFrameRate(int newMaxFrameRate);
+
+Q_SIGNALS:
+    void surfaceChanged();
+    void radiusChanged();
+    void fullResolutionChanged();
+    void maxFrameRateChanged();
+
+private:
+    void geometryChange(const QRectF &newGeo, const QRectF &oldGeo) override;
+    void itemChange(ItemChange change, const ItemChangeData &data) override;
+    void onCommitted();
+    void onUpdateTimeout();
+    void scheduleTextureUpdate();
+    void updateTextureSize();
+    void updateMode();
+
+    SurfaceWrapper *m_surface = nullptr;
+    SurfaceProxy *m_proxy;
+    QQuickShaderEffectSource *m_texture;
+    QTimer *m_updateTimer;
+    QMetaObject::Connection m_commitConnection;
+    int m_maxFrameRate = 10;
+    uint m_fullResolution : 1;
+    uint m_dirty : 1;
+};
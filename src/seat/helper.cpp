@@ -20,8 +20,11 @@
 #endif
 #include "interfaces/multitaskviewinterface.h"
 #include "output/output.h"
+#include "output/outputconfigstore.h"
 #include "modules/primary-output/outputmanagement.h"
 #include "modules/personalization/personalizationmanager.h"
+#include "core/blurservice.h"
+#include "core/dockpreviewcache.h"
 #include "core/qmlengine.h"
 #include "core/rootsurfacecontainer.h"
 #include "core/shellhandler.h"
@@ -32,6 +35,7 @@
 #include "config/treelandconfig.h"
 #include "modules/wallpaper-color/wallpapercolor.h"
 #include "core/windowpicker.h"
+#include "workspace/showdesktopanimator.h"
 #include "workspace/workspace.h"
 
 #include <xcb/xcb.h>
@@ -163,6 +167,7 @@ Helper::Helper(QObject *parent)
 #endif
 
     m_shellHandler = new ShellHandler(m_rootSurfaceContainer);
+    m_blurService = new BlurService(this);
 
     m_workspaceScaleAnimation = new QPropertyAnimation(m_shellHandler->workspace(), "scale", this);
     m_workspaceOpacityAnimation =
@@ -302,6 +307,16 @@ Workspace *Helper::workspace() const
     return m_shellHandler->workspace();
 }
 
+DockPreviewCache *Helper::dockPreviewCache() const
+{
+    return m_dockPreviewCache;
+}
+
+BlurService *Helper::blurService() const
+{
+    return m_blurService;
+}
+
 void Helper::onOutputAdded(WOutput *output)
 {
     // TODO: 应该让helper发出Output的信号，每个需要output的单元单独connect。
@@ -334,13 +349,9 @@ void Helper::onOutputRemoved(WOutput *output)
         if (output == m_rootSurfaceContainer->primaryOutput()->output())
             m_rootSurfaceContainer->removeOutput(o);
 
-        for (int i = 0; i < m_outputList.size(); i++) {
-            if (m_outputList.at(i) == m_rootSurfaceContainer->primaryOutput())
-                continue;
-            Output *o1 = createNormalOutput(m_outputList.at(i)->output());
-            o1->enable();
-            m_outputList.at(i)->deleteLater();
-            m_outputList.replace(i, o1);
+        for (Output *o1 : std::as_const(m_outputList)) {
+            if (o1 != m_rootSurfaceContainer->primaryOutput())
+                setOutputProxy(o1, nullptr);
         }
     }
 
@@ -398,7 +409,12 @@ void Helper::onOutputTestOrApply(qw_output_configuration_v1 *config, bool onlyTe
                                          state.customModeSize.height(),
                                          state.customModeRefresh);
 
-            newState.set_adaptive_sync_enabled(state.adaptiveSyncEnabled);
+            // Only asked for on a change, so that configurations keeping it off
+            // still pass on outputs without support
+            const bool adaptiveSync = output->nativeHandle()->adaptive_sync_status
+                == WLR_OUTPUT_ADAPTIVE_SYNC_ENABLED;
+            if (state.adaptiveSyncEnabled != adaptiveSync)
+                newState.set_adaptive_sync_enabled(state.adaptiveSyncEnabled);
             if (!onlyTest) {
                 newState.set_transform(static_cast<wl_output_transform>(state.transform));
                 newState.set_scale(state.scale);
@@ -416,6 +432,31 @@ void Helper::onOutputTestOrApply(qw_output_configuration_v1 *config, bool onlyTe
         else
             ok &= output->handle()->commit_state(newState);
     }
+
+    if (!onlyTest && ok) {
+        // Applied again by the first commit when the monitor comes back
+        OutputConfigStore store;
+        for (const auto &state : std::as_const(states)) {
+            if (!state.enabled)
+                continue;
+
+            OutputConfig saved;
+            if (state.mode) {
+                saved.modeSize = QSize(state.mode->width, state.mode->height);
+                saved.refresh = state.mode->refresh;
+            } else {
+                saved.modeSize = state.customModeSize;
+                saved.refresh = state.customModeRefresh;
+            }
+            saved.scale = state.scale;
+            saved.transform = static_cast<int>(state.transform);
+            saved.position = QPoint(state.x, state.y);
+            saved.adaptiveSync = state.adaptiveSyncEnabled;
+            auto o = getOutput(state.output);
+            saved.primary = o && o == m_rootSurfaceContainer->primaryOutput();
+            store.setConfig(OutputConfigStore::identity(state.output), saved);
+        }
+    }
     m_outputManager->sendResult(config, ok);
 }
 
@@ -427,6 +468,7 @@ void Helper::onDockPreview(std::vector<SurfaceWrapper *> surfaces,
     SurfaceWrapper *dockWrapper = m_rootSurfaceContainer->getSurface(target);
     Q_ASSERT(dockWrapper);
 
+    m_dockPreviewCache->setShownSurfaces(surfaces);
     QMetaObject::invokeMethod(m_dockPreview,
                               "show",
                               QVariant::fromValue(surfaces),
@@ -459,17 +501,7 @@ void Helper::onShowDesktop()
         return;
 
     m_showDesktop = s;
-    const auto &surfaces = getWorkspaceSurfaces();
-    for (auto &surface : surfaces) {
-        if (surface->isMinimized()) {
-            continue;
-        }
-        if (s == WindowManagementV1::DesktopState::Normal) {
-            surface->startShowDesktopAnimation(true);
-        } else if (s == WindowManagementV1::DesktopState::Show) {
-            surface->startShowDesktopAnimation(false);
-        }
-    }
+    m_showDesktopAnimator->start(s == WindowManagementV1::DesktopState::Normal);
 }
 
 void Helper::onSetCopyOutput(treeland_virtual_output_v1 *virtual_output)
@@ -495,8 +527,8 @@ void Helper::onSetCopyOutput(treeland_virtual_output_v1 *virtual_output)
             mirrorOutput = output;
     }
 
-    for (int i = 0; i < m_outputList.size(); i++) {
-        Output *currentOutput = m_outputList.at(i);
+    m_mode = OutputMode::Copy;
+    for (Output *currentOutput : std::as_const(m_outputList)) {
         if (currentOutput == mirrorOutput)
             continue;
 
@@ -505,28 +537,17 @@ void Helper::onSetCopyOutput(treeland_virtual_output_v1 *virtual_output)
         if (m_rootSurfaceContainer->primaryOutput() == currentOutput)
             m_rootSurfaceContainer->setPrimaryOutput(mirrorOutput);
 
-        Output *o = createCopyOutput(currentOutput->output(), mirrorOutput);
-        m_rootSurfaceContainer->removeOutput(currentOutput);
-        currentOutput->deleteLater();
-        m_outputList.replace(i, o);
+        setOutputProxy(currentOutput, mirrorOutput);
     }
-
-    m_mode = OutputMode::Copy;
-    const auto &surfaces = getWorkspaceSurfaces();
-    moveSurfacesToOutput(surfaces, mirrorOutput, nullptr);
 }
 
 void Helper::onRestoreCopyOutput(treeland_virtual_output_v1 *virtual_output)
 {
-    for (int i = 0; i < m_outputList.size(); i++) {
-        Output *currentOutput = m_outputList.at(i);
+    for (Output *currentOutput : std::as_const(m_outputList)) {
         if (currentOutput->output()->name() == virtual_output->outputList.at(0))
             continue;
 
-        Output *o = createNormalOutput(m_outputList.at(i)->output());
-        o->enable();
-        m_outputList.at(i)->deleteLater();
-        m_outputList.replace(i, o);
+        setOutputProxy(currentOutput, nullptr);
     }
     m_mode = OutputMode::Extension;
 }
@@ -680,6 +701,20 @@ void Helper::deleteTaskSwitch()
     }
 }
 
+// The switcher stays hidden on the primary output between uses, so Alt+Tab
+// neither instantiates qml nor sets up thumbnails
+void Helper::createTaskSwitch()
+{
+    deleteTaskSwitch();
+
+    auto output = m_rootSurfaceContainer->primaryOutput();
+    if (!output)
+        return;
+
+    m_taskSwitch = qmlEngine()->createTaskSwitcher(output, window()->contentItem());
+    m_taskSwitch->setZ(RootSurfaceContainer::OverlayZOrder);
+}
+
 void Helper::init()
 {
     auto engine = qmlEngine();
@@ -690,6 +725,14 @@ void Helper::init()
     m_rootSurfaceContainer->setQmlEngine(engine);
     m_rootSurfaceContainer->init(m_server);
 
+    m_showDesktopAnimator = new ShowDesktopAnimator(workspace(), engine);
+    connect(m_showDesktopAnimator, &ShowDesktopAnimator::applyState, this, [this](bool show) {
+        for (auto surface : getWorkspaceSurfaces()) {
+            if (!surface->isMinimized())
+                surface->setHideByShowDesk(show);
+        }
+    });
+
     m_seat = m_server->attach<WSeat>();
     m_seat->setEventFilter(this);
     m_seat->setCursor(m_rootSurfaceContainer->cursor());
@@ -828,6 +871,8 @@ void Helper::init()
                 for (auto &&output : m_rootSurfaceContainer->outputs()) {
                     if (strcmp(output->output()->nativeHandle()->name, name) == 0) {
                         m_rootSurfaceContainer->setPrimaryOutput(output);
+                        OutputConfigStore().setPrimary(
+                            OutputConfigStore::identity(output->output()));
                     }
                 }
             });
@@ -840,6 +885,7 @@ void Helper::init()
                 m_lockScreen->setPrimaryOutputName(m_rootSurfaceContainer->primaryOutput()->output()->name());
             }
         }
+        createTaskSwitch();
     });
 
     qmlRegisterUncreatableType<Personalization>("Treeland.Protocols",
@@ -927,6 +973,9 @@ void Helper::init()
     qw_fractional_scale_manager_v1::create(*m_server->handle(), WLR_FRACTIONAL_SCALE_V1_VERSION);
     qw_data_control_manager_v1::create(*m_server->handle());
 
+    m_dockPreviewCache = new DockPreviewCache(this);
+    engine->addImageProvider(DockPreviewCache::ProviderId,
+                             m_dockPreviewCache->createImageProvider());
     m_dockPreview = engine->createDockPreview(m_renderWindow->contentItem());
 
     connect(m_treelandForeignToplevel,
@@ -942,6 +991,7 @@ void Helper::init()
             &ForeignToplevelV1::requestDockClose,
             m_dockPreview,
             [this]() {
+                m_dockPreviewCache->setShownSurfaces({});
                 QMetaObject::invokeMethod(m_dockPreview, "close");
             });
 
@@ -1133,18 +1183,15 @@ bool Helper::beforeDisposeEvent(WSeat *seat, QWindow *, QInputEvent *event)
                     return true;
                 }
 
-                if (m_taskSwitch.isNull()) {
-                    auto contentItem = window()->contentItem();
-                    auto output = rootContainer()->primaryOutput();
-                    m_taskSwitch = qmlEngine()->createTaskSwitcher(output, contentItem);
+                if (m_taskSwitch.isNull())
+                    createTaskSwitch();
+                if (m_taskSwitch.isNull())
+                    return true;
 
+                if (!m_taskSwitch->property("switchOn").toBool()) {
                     // Restore the real state of the window when Task Switche
                     restoreFromShowDesktop();
-                    connect(m_taskSwitch,
-                            SIGNAL(switchOnChanged()),
-                            this,
-                            SLOT(deleteTaskSwitch()));
-                    m_taskSwitch->setZ(RootSurfaceContainer::OverlayZOrder);
+                    QMetaObject::invokeMethod(m_taskSwitch, "enter");
                 }
 
                 if (kevent->isAutoRepeat()) {
@@ -1186,7 +1233,7 @@ bool Helper::beforeDisposeEvent(WSeat *seat, QWindow *, QInputEvent *event)
                 Q_EMIT m_activatedSurface->requestShowWindowMenu({ 0, 0 });
                 return true;
             }
-            if (m_taskSwitch) {
+            if (m_taskSwitch && m_taskSwitch->property("switchOn").toBool()) {
                 if (kevent->key() == Qt::Key_Left) {
                     QMetaObject::invokeMethod(m_taskSwitch, "previous");
                     return true;
@@ -1349,22 +1396,32 @@ bool Helper::doGesture(QInputEvent *event)
     return false;
 }
 
-Output *Helper::createNormalOutput(WOutput *output)
+Output *Helper::createOutput(WOutput *output)
 {
     Output *o = Output::create(output, qmlEngine(), this);
     auto future = QtConcurrent::run([o, this]() {
         if (isNvidiaCardPresent()) {
-            o->outputItem()->setProperty("forceSoftwareCursor", true);
+            QMetaObject::invokeMethod(o, [o, this] {
+                o->holdSoftwareCursor(this);
+            });
         }
     });
     o->outputItem()->stackBefore(m_rootSurfaceContainer);
+    return o;
+}
+
+Output *Helper::createNormalOutput(WOutput *output)
+{
+    Output *o = createOutput(output);
     m_rootSurfaceContainer->addOutput(o);
     return o;
 }
 
 Output *Helper::createCopyOutput(WOutput *output, Output *proxy)
 {
-    return Output::createCopy(output, proxy, qmlEngine(), this);
+    Output *o = createOutput(output);
+    o->setProxy(proxy);
+    return o;
 }
 
 QList<SurfaceWrapper *> Helper::getWorkspaceSurfaces(Output *filterOutput)
@@ -1483,6 +1540,7 @@ void Helper::setActivatedSurface(SurfaceWrapper *newActivateSurface)
 
     if (newActivateSurface) {
         if (m_showDesktop == WindowManagementV1::DesktopState::Show) {
+            m_showDesktopAnimator->stop();
             m_showDesktop = WindowManagementV1::DesktopState::Normal;
             m_windowManagement->setDesktopState(WindowManagementV1::DesktopState::Normal);
             newActivateSurface->setHideByShowDesk(true);
@@ -1618,24 +1676,33 @@ void Helper::setOutputMode(OutputMode mode)
         return;
     m_mode = mode;
     Q_EMIT outputModeChanged();
-    for (int i = 0; i < m_outputList.size(); i++) {
-        if (m_outputList.at(i) == m_rootSurfaceContainer->primaryOutput())
-            continue;
-        Output *o;
-        if (mode == OutputMode::Copy) {
-            o = createCopyOutput(m_outputList.at(i)->output(),
-                                 m_rootSurfaceContainer->primaryOutput());
-            m_rootSurfaceContainer->removeOutput(m_outputList.at(i));
-        } else if (mode == OutputMode::Extension) {
-            o = createNormalOutput(m_outputList.at(i)->output());
-            o->enable();
-        }
-        m_outputList.at(i)->deleteLater();
-        m_outputList.replace(i, o);
+    Output *primaryOutput = m_rootSurfaceContainer->primaryOutput();
+    for (Output *o : std::as_const(m_outputList)) {
+        if (o != primaryOutput)
+            setOutputProxy(o, mode == OutputMode::Copy ? primaryOutput : nullptr);
     }
 }
 
-void Helper::setOutputProxy(Output *output) { }
+// Switches the role of output in place. Its items stay alive, and only the
+// surfaces it showed move when it leaves the layout.
+void Helper::setOutputProxy(Output *output, Output *proxy)
+{
+    if (proxy == output->proxy())
+        return;
+
+    const bool inLayout = output->isPrimary();
+    if (proxy && inLayout) {
+        const auto surfaces = getWorkspaceSurfaces(output);
+        m_rootSurfaceContainer->removeOutput(output);
+        output->setProxy(proxy);
+        moveSurfacesToOutput(surfaces, proxy, output);
+        return;
+    }
+
+    output->setProxy(proxy);
+    if (!proxy && !inLayout)
+        m_rootSurfaceContainer->addOutput(output);
+}
 
 float Helper::animationSpeed() const
 {
@@ -1793,8 +1860,13 @@ void Helper::setCurrentMode(CurrentMode mode)
 
     TreelandConfig::ref().setBlockActivateSurface(mode != CurrentMode::Normal);
 
+    const bool unlocking = m_currentMode == CurrentMode::LockScreen;
     m_currentMode = mode;
 
+    // Locking discards the switcher, have it warm again for the next Alt+Tab
+    if (unlocking && !m_taskSwitch)
+        createTaskSwitch();
+
     Q_EMIT currentModeChanged();
 }
 
@@ -1858,6 +1930,7 @@ void Helper::handleWhellValueChanged(const QInputEvent *event)
 void Helper::restoreFromShowDesktop(SurfaceWrapper *activeSurface)
 {
     if (m_showDesktop == WindowManagementV1::DesktopState::Show) {
+        m_showDesktopAnimator->stop();
         m_showDesktop = WindowManagementV1::DesktopState::Normal;
         m_windowManagement->setDesktopState(WindowManagementV1::DesktopState::Normal);
         if (activeSurface) {
@@ -21,6 +21,8 @@ Q_MOC_INCLUDE(<qwoutputmanagementv1.h>)
 Q_MOC_INCLUDE("surface/surfacewrapper.h")
 Q_MOC_INCLUDE("workspace/workspace.h")
 Q_MOC_INCLUDE("core/rootsurfacecontainer.h")
+Q_MOC_INCLUDE("core/blurservice.h")
+Q_MOC_INCLUDE("core/dockpreviewcache.h")
 Q_MOC_INCLUDE("modules/capture/capture.h")
 Q_MOC_INCLUDE(<wlayersurface.h>)
 Q_MOC_INCLUDE(<QDBusObjectPath>)
@@ -66,6 +68,9 @@ class Output;
 class SurfaceWrapper;
 class SurfaceContainer;
 class RootSurfaceContainer;
+class BlurService;
+class DockPreviewCache;
+class ShowDesktopAnimator;
 class ForeignToplevelV1;
 class LockScreen;
 class ShortcutV1;
@@ -99,6 +104,8 @@ class Helper : public WSeatEventFilter
     Q_PROPERTY(TogglableGesture* windowGesture READ windowGesture CONSTANT)
     Q_PROPERTY(SurfaceWrapper* activatedSurface READ activatedSurface NOTIFY activatedSurfaceChanged FINAL)
     Q_PROPERTY(Workspace* workspace READ workspace CONSTANT FINAL)
+    Q_PROPERTY(DockPreviewCache* dockPreviewCache READ dockPreviewCache CONSTANT FINAL)
+    Q_PROPERTY(BlurService* blurService READ blurService CONSTANT FINAL)
     QML_ELEMENT
     QML_SINGLETON
 
@@ -128,6 +135,8 @@ public:
     WOutputRenderWindow *window() const;
     ShellHandler *shellHandler() const;
     Workspace *workspace() const;
+    DockPreviewCache *dockPreviewCache() const;
+    BlurService *blurService() const;
 
     void init();
 
@@ -176,6 +185,7 @@ public:
     void handleWindowPicker(WindowPickerInterface *picker);
 
     RootSurfaceContainer *rootSurfaceContainer() const;
+    SurfaceWrapper *activatedSurface() const;
 
     void setMultitaskViewImpl(IMultitaskView *impl);
     void setLockScreenImpl(ILockScreen *impl);
@@ -213,6 +223,7 @@ Q_SIGNALS:
 private Q_SLOTS:
     void onShowDesktop();
     void deleteTaskSwitch();
+    void createTaskSwitch();
 
 private:
     void onOutputAdded(WOutput *output);
@@ -243,11 +254,10 @@ private:
 
     int indexOfOutput(WOutput *output) const;
 
-    void setOutputProxy(Output *output);
+    void setOutputProxy(Output *output, Output *proxy);
 
     SurfaceWrapper *keyboardFocusSurface() const;
     void requestKeyboardFocusForSurface(SurfaceWrapper *newActivateSurface, Qt::FocusReason reason);
-    SurfaceWrapper *activatedSurface() const;
     void setActivatedSurface(SurfaceWrapper *newActivateSurface);
 
     void setCursorPosition(const QPointF &position);
@@ -263,6 +273,7 @@ private:
     void handleLeftButtonStateChanged(const QInputEvent *event);
     void handleWhellValueChanged(const QInputEvent *event);
     bool doGesture(QInputEvent *event);
+    Output *createOutput(WOutput *output);
     Output *createNormalOutput(WOutput *output);
     Output *createCopyOutput(WOutput *output, Output *proxy);
     QList<SurfaceWrapper *> getWorkspaceSurfaces(Output *filterOutput = nullptr);
@@ -280,6 +291,9 @@ private:
     // qtquick helper
     WOutputRenderWindow *m_renderWindow = nullptr;
     QQuickItem *m_dockPreview = nullptr;
+    DockPreviewCache *m_dockPreviewCache = nullptr;
+    BlurService *m_blurService = nullptr;
+    ShowDesktopAnimator *m_showDesktopAnimator = nullptr;
 
     // gesture
     TogglableGesture *m_multiTaskViewGesture = nullptr;
@@ -0,0 +1,44 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "surface/appidindex.h"
+
+#include "surface/surfacewrapper.h"
+
+void AppIdIndex::setSurfaces(const QList<SurfaceWrapper *> &surfaces)
+{
+    clear();
+    m_next.resize(surfaces.size());
+    m_prev.resize(surfaces.size());
+
+    for (int row = 0; row < surfaces.size(); ++row)
+        m_groups[surfaces[row]->appId()].append(row);
+
+    for (const auto &group : std::as_const(m_groups)) {
+        for (qsizetype i = 0; i < group.size(); ++i) {
+            m_next[group[i]] = group[(i + 1) % group.size()];
+            m_prev[group[i]] = group[(i + group.size() - 1) % group.size()];
+        }
+    }
+}
+
+void AppIdIndex::clear()
+{
+    m_groups.clear();
+    m_next.clear();
+    m_prev.clear();
+}
+
+int AppIdIndex::next(int row) const
+{
+    if (row < 0 || row >= m_next.size())
+        return -1;
+    return m_next[row];
+}
+
+int AppIdIndex::prev(int row) const
+{
+    if (row < 0 || row >= m_prev.size())
+        return -1;
+    return m_prev[row];
+}
@@ -0,0 +1,28 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+class SurfaceWrapper;
+
+// Groups an ordered surface list by the cached app id of each surface. The
+// ids are hashed once per rebuild, then surfaces of the same app are linked
+// in list order and next()/prev() are plain row lookups.
+class AppIdIndex
+{
+public:
+    void setSurfaces(const QList<SurfaceWrapper *> &surfaces);
+    void clear();
+
+    // Circular within the app group, returns row itself when it is alone and -1 when out of range
+    int next(int row) const;
+    int prev(int row) const;
+
+private:
+    QHash<QString, QList<int>> m_groups;
+    QList<int> m_next;
+    QList<int> m_prev;
+};
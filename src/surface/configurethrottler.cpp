@@ -0,0 +1,147 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "surface/configurethrottler.h"
+
+#include "surface/surfacewrapper.h"
+
+#include <wclient.h>
+#include <wsurface.h>
+#include <wtoplevelsurface.h>
+#include <wxdgtoplevelsurface.h>
+
+#include <qwcompositor.h>
+#include <qwxdgshell.h>
+
+#include <QHash>
+#include <QLoggingCategory>
+#include <QTimer>
+
+Q_LOGGING_CATEGORY(qLcConfigureThrottler, "treeland.surface.configure", QtWarningMsg)
+
+// A client that does not commit within this time gets the next configure anyway
+static constexpr int ConfigureTimeout = 100;
+
+namespace {
+struct ClientLatency
+{
+    qreal average = 0;
+    qint64 max = 0;
+    quint32 count = 0;
+    quint32 timeouts = 0;
+};
+
+QHash<WClient *, ClientLatency> &clientLatencies()
+{
+    static QHash<WClient *, ClientLatency> latencies;
+    return latencies;
+}
+} // namespace
+
+ConfigureThrottler::ConfigureThrottler(SurfaceWrapper *surface)
+    : QObject(surface)
+    , m_surface(surface)
+    , m_timeout(new QTimer(this))
+{
+    m_timeout->setSingleShot(true);
+    m_timeout->setInterval(ConfigureTimeout);
+    connect(m_timeout, &QTimer::timeout, this, &ConfigureThrottler::onTimeout);
+
+    auto wsurface = surface->surface();
+    wsurface->handle()->safeConnect(&qw_surface::notify_commit,
+                                    this,
+                                    &ConfigureThrottler::onCommitted);
+
+    m_client = wsurface->waylandClient();
+    if (m_client && !clientLatencies().contains(m_client)) {
+        clientLatencies().insert(m_client, {});
+        connect(m_client, &WClient::destroyed, m_client, [client = m_client] {
+            clientLatencies().remove(client);
+        });
+    }
+}
+
+ConfigureThrottler::~ConfigureThrottler() = default;
+
+void ConfigureThrottler::resize(const QSizeF &size)
+{
+    m_pendingSize = size;
+    m_hasPending = true;
+
+    if (!m_waiting)
+        sendPending();
+}
+
+void ConfigureThrottler::flush()
+{
+    m_timeout->stop();
+    m_waiting = false;
+    sendPending();
+}
+
+wlr_xdg_surface *ConfigureThrottler::xdgSurface() const
+{
+    auto toplevel = qobject_cast<WXdgToplevelSurface *>(m_surface->shellSurface());
+    return toplevel ? toplevel->handle()->handle()->base : nullptr;
+}
+
+void ConfigureThrottler::sendPending()
+{
+    if (!m_hasPending)
+        return;
+
+    m_hasPending = false;
+    // A size the client already has doesn't produce a configure
+    if (!m_surface->resize(m_pendingSize))
+        return;
+
+    if (auto xdg = xdgSurface())
+        m_serial = xdg->scheduled_serial;
+    m_waiting = true;
+    m_configureTime.start();
+    m_timeout->start();
+}
+
+void ConfigureThrottler::onCommitted()
+{
+    if (!m_waiting)
+        return;
+    // Commits of content drawn at an older size don't answer the configure,
+    // serials wrap so compare their distance
+    if (auto xdg = xdgSurface(); xdg && int32_t(xdg->current.configure_serial - m_serial) < 0)
+        return;
+
+    m_timeout->stop();
+    m_waiting = false;
+    recordLatency(m_configureTime.elapsed());
+    sendPending();
+}
+
+void ConfigureThrottler::onTimeout()
+{
+    Q_ASSERT(m_waiting);
+    m_waiting = false;
+
+    if (m_client)
+        ++clientLatencies()[m_client].timeouts;
+    qCDebug(qLcConfigureThrottler) << "Configure of" << m_surface << "not committed within"
+                                   << ConfigureTimeout << "ms";
+    recordLatency(m_configureTime.elapsed());
+    sendPending();
+}
+
+void ConfigureThrottler::recordLatency(qint64 latency)
+{
+    if (!m_client)
+        return;
+
+    auto &stats = clientLatencies()[m_client];
+    ++stats.count;
+    stats.max = qMax(stats.max, latency);
+    // Exponential moving average, the first sample seeds it
+    stats.average = stats.count == 1 ? latency : stats.average * 0.875 + latency * 0.125;
+
+    qCDebug(qLcConfigureThrottler) << "Resize latency of client" << m_client << latency
+                                   << "ms, average" << stats.average << "max" << stats.max
+                                   << "timeouts" << stats.timeouts;
+}
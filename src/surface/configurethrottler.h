@@ -0,0 +1,57 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wglobal.h>
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QSizeF>
+
+WAYLIB_SERVER_BEGIN_NAMESPACE
+class WClient;
+WAYLIB_SERVER_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+class SurfaceWrapper;
+struct wlr_xdg_surface;
+
+// Keeps at most one resize configure in flight for a surface during an
+// interactive resize. Newer sizes replace the pending one and are sent once the
+// client commits a state acking the configure in flight, or after a timeout
+// for clients that never answer. XWayland has no configure serials, there any
+// commit counts as the answer.
+class ConfigureThrottler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ConfigureThrottler(SurfaceWrapper *surface);
+    ~ConfigureThrottler() override;
+
+    void resize(const QSizeF &size);
+    // Send the pending size right now, used when the interactive resize ends
+    void flush();
+
+private:
+    wlr_xdg_surface *xdgSurface() const;
+    void sendPending();
+    void onCommitted();
+    void onTimeout();
+    void recordLatency(qint64 latency);
+
+    SurfaceWrapper *m_surface;
+    WClient *m_client = nullptr;
+    QTimer *m_timeout;
+    QElapsedTimer m_configureTime;
+    QSizeF m_pendingSize;
+    bool m_hasPending = false;
+    bool m_waiting = false;
+    // Serial of the configure in flight, xdg surfaces only
+    uint32_t m_serial = 0;
+};
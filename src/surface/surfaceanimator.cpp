@@ -0,0 +1,308 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "surface/surfaceanimator.h"
+
+#include "core/qmlengine.h"
+#include "seat/helper.h"
+#include "surface/surfacewrapper.h"
+
+#include <QQmlEngine>
+#include <QVariantAnimation>
+
+#include <private/qquickshadereffectsource_p.h>
+#include <private/qquicktranslate_p.h>
+
+SurfaceAnimator::SurfaceAnimator(SurfaceWrapper *surface, QmlEngine *engine)
+    : QQuickItem()
+    , m_surface(surface)
+    , m_engine(engine)
+    , m_animation(new QVariantAnimation(this))
+    , m_rotation(new QQuickRotation(this))
+{
+    QObject::setParent(surface);
+    QQmlEngine::setContextForObject(this, engine->rootContext());
+    setVisible(false);
+
+    m_rotation->setAxis(QVector3D(1, 0, 0));
+    m_rotation->appendToItem(this);
+
+    m_animation->setStartValue(0.0);
+    m_animation->setEndValue(1.0);
+    connect(m_animation,
+            &QVariantAnimation::valueChanged,
+            this,
+            &SurfaceAnimator::updateProgress);
+    connect(m_animation,
+            &QVariantAnimation::finished,
+            this,
+            &SurfaceAnimator::onAnimationFinished);
+}
+
+SurfaceAnimator::~SurfaceAnimator()
+{
+    m_animation->stop();
+    cleanup();
+}
+
+SurfaceAnimator::Effect SurfaceAnimator::effect() const
+{
+    return m_effect;
+}
+
+bool SurfaceAnimator::isRunning() const
+{
+    return m_effect != Effect::None;
+}
+
+void SurfaceAnimator::startGeometry(const QRectF &fromGeometry,
+                                    const QRectF &toGeometry,
+                                    QQuickItem *parent,
+                                    bool enableBlur)
+{
+    m_fromGeometry = fromGeometry;
+    m_toGeometry = toGeometry;
+    prepare(Effect::Geometry, parent, 200 * Helper::instance()->animationSpeed(), enableBlur);
+
+    m_content = createEffectSource(true, true);
+    m_snapshot = createEffectSource(false, false);
+    m_snapshotRect = m_surface->boundingRect();
+    m_snapshot->setSourceRect(m_snapshotRect);
+    // The first grab of a non-live source completes once the old content is captured
+    connect(m_snapshot,
+            &QQuickShaderEffectSource::scheduledUpdateCompleted,
+            this,
+            &SurfaceAnimator::ready,
+            Qt::SingleShotConnection);
+
+    updateGeometry(0);
+    m_animation->start();
+}
+
+void SurfaceAnimator::setTargetGeometry(const QRectF &toGeometry)
+{
+    if (m_effect != Effect::Geometry)
+        return;
+    m_toGeometry = toGeometry;
+}
+
+void SurfaceAnimator::startWindow(bool show, QQuickItem *parent, bool enableBlur)
+{
+    m_show = show;
+    prepare(Effect::Window, parent, 400 * Helper::instance()->animationSpeed(), enableBlur);
+    setPosition(m_surface->position());
+    setSize(m_surface->size());
+    m_rotation->setOrigin(QVector3D(width() / 2, height() / 2, 0));
+
+    m_content = createEffectSource(show, true);
+    // 50 > shadow width
+    const QRectF rect(-50, -50, m_surface->width() + 100, m_surface->height() + 100);
+    m_content->setSourceRect(rect);
+    m_content->setPosition(rect.topLeft());
+    m_content->setSize(rect.size());
+
+    updateWindow(0);
+    m_animation->start();
+}
+
+void SurfaceAnimator::startLayerShell(bool show,
+                                      WLayerSurface::AnchorType position,
+                                      QQuickItem *parent,
+                                      bool enableBlur)
+{
+    m_show = show;
+    m_position = position;
+    prepare(Effect::LayerShell, parent, 1000, false);
+    setClip(true);
+    setPosition(m_surface->position());
+    setSize(m_surface->size());
+
+    m_content = createEffectSource(show, true);
+    m_content->setSize(m_surface->size());
+    if (enableBlur) {
+        // Slides with the content but keeps its full opacity, the blur is
+        // under the panel and not part of it
+        m_blur = new QQuickItem(this);
+        m_blur->setSize(m_content->size());
+        m_blur->stackBefore(m_content);
+        m_engine->createBlur(m_blur, 0);
+    }
+
+    updateLayerShell(0);
+    m_animation->start();
+}
+
+void SurfaceAnimator::startLaunchpad(bool show, QQuickItem *parent)
+{
+    m_show = show;
+    prepare(Effect::Launchpad, parent, 400 * Helper::instance()->animationSpeed(), false);
+    setClip(true);
+    setPosition(m_surface->position());
+    setSize(m_surface->size());
+
+    m_content = createEffectSource(show, true);
+    m_content->setSize(m_surface->size());
+
+    updateLaunchpad(0);
+    m_animation->start();
+}
+
+void SurfaceAnimator::stop()
+{
+    if (!isRunning())
+        return;
+
+    m_animation->stop();
+    cleanup();
+}
+
+void SurfaceAnimator::prepare(Effect effect, QQuickItem *parent, int duration, bool enableBlur)
+{
+    Q_ASSERT(!isRunning());
+    m_effect = effect;
+
+    setParentItem(parent);
+    setClip(false);
+    setOpacity(1.0);
+    setScale(1.0);
+    m_rotation->setAngle(0);
+    setVisible(true);
+
+    if (enableBlur)
+        m_blur = m_engine->createBlur(this, m_surface->radius());
+
+    m_animation->setDuration(duration);
+}
+
+QQuickShaderEffectSource *SurfaceAnimator::createEffectSource(bool live, bool hideSource)
+{
+    auto source = new QQuickShaderEffectSource(this);
+    QQmlEngine::setContextForObject(source, qmlContext(this));
+    source->setLive(live);
+    source->setHideSource(hideSource);
+    source->setSourceItem(m_surface);
+    return source;
+}
+
+void SurfaceAnimator::updateProgress(const QVariant &value)
+{
+    const qreal progress = value.toReal();
+    switch (m_effect) {
+    case Effect::Geometry:
+        updateGeometry(progress);
+        break;
+    case Effect::Window:
+        updateWindow(progress);
+        break;
+    case Effect::LayerShell:
+        updateLayerShell(progress);
+        break;
+    case Effect::Launchpad:
+        updateLaunchpad(progress);
+        break;
+    case Effect::None:
+        break;
+    }
+}
+
+void SurfaceAnimator::updateGeometry(qreal progress)
+{
+    const qreal p = m_outCubic.valueForProgress(progress);
+    auto interpolate = [p](qreal from, qreal to) {
+        return from + (to - from) * p;
+    };
+    setPosition({ interpolate(m_fromGeometry.x(), m_toGeometry.x()),
+                  interpolate(m_fromGeometry.y(), m_toGeometry.y()) });
+    setSize({ interpolate(m_fromGeometry.width(), m_toGeometry.width()),
+              interpolate(m_fromGeometry.height(), m_toGeometry.height()) });
+
+    if (m_content && !m_surface->size().isEmpty()) {
+        const QRectF rect = m_surface->boundingRect();
+        const qreal xScale = width() / m_surface->width();
+        const qreal yScale = height() / m_surface->height();
+        m_content->setSourceRect(rect);
+        m_content->setPosition({ rect.x() * xScale, rect.y() * yScale });
+        m_content->setSize({ rect.width() * xScale, rect.height() * yScale });
+    }
+
+    if (m_snapshot && !m_fromGeometry.size().isEmpty()) {
+        const qreal xScale = width() / m_fromGeometry.width();
+        const qreal yScale = height() / m_fromGeometry.height();
+        m_snapshot->setPosition({ m_snapshotRect.x() * xScale, m_snapshotRect.y() * yScale });
+        m_snapshot->setSize({ m_snapshotRect.width() * xScale, m_snapshotRect.height() * yScale });
+        // The old content fades out during the first half of the animation
+        m_snapshot->setOpacity(1.0 - m_outCubic.valueForProgress(qMin(1.0, progress * 2)));
+    }
+}
+
+void SurfaceAnimator::updateWindow(qreal progress)
+{
+    const qreal p = m_outExpo.valueForProgress(progress);
+    const qreal shown = m_show ? p : 1.0 - p;
+    m_rotation->setAngle(75 * (1.0 - shown));
+    setScale(0.3 + 0.7 * shown);
+    setOpacity(shown);
+}
+
+void SurfaceAnimator::updateLayerShell(qreal progress)
+{
+    const qreal p = m_outExpo.valueForProgress(progress);
+    const qreal hidden = m_show ? 1.0 - p : p;
+    QPointF offset;
+    switch (m_position) {
+    case WLayerSurface::AnchorType::Top:
+        offset.setY(-m_content->height() * hidden);
+        break;
+    case WLayerSurface::AnchorType::Bottom:
+        offset.setY(m_content->height() * hidden);
+        break;
+    case WLayerSurface::AnchorType::Left:
+        offset.setX(-m_content->width() * hidden);
+        break;
+    case WLayerSurface::AnchorType::Right:
+        offset.setX(m_content->width() * hidden);
+        break;
+    default:
+        break;
+    }
+    m_content->setPosition(offset);
+    m_content->setOpacity(1.0 - 0.8 * hidden);
+    if (m_blur)
+        m_blur->setPosition(offset);
+}
+
+void SurfaceAnimator::updateLaunchpad(qreal progress)
+{
+    const qreal p = m_outExpo.valueForProgress(progress);
+    const qreal shown = m_show ? p : 1.0 - p;
+    m_content->setOpacity(shown);
+    m_content->setScale(0.3 + 0.7 * shown);
+}
+
+void SurfaceAnimator::onAnimationFinished()
+{
+    cleanup();
+    Q_EMIT finished();
+}
+
+void SurfaceAnimator::cleanup()
+{
+    m_effect = Effect::None;
+    setVisible(false);
+
+    for (auto source : { m_content, m_snapshot }) {
+        if (!source)
+            continue;
+        source->disconnect(this);
+        // Release hideSource right now, the item itself goes with the next event loop
+        source->setSourceItem(nullptr);
+        source->deleteLater();
+    }
+    m_content = nullptr;
+    m_snapshot = nullptr;
+
+    if (m_blur) {
+        m_blur->deleteLater();
+        m_blur = nullptr;
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <wlayersurface.h>
+
+#include <QEasingCurve>
+#include <QPointer>
+#include <QQuickItem>
+
+QT_BEGIN_NAMESPACE
+class QVariantAnimation;
+class QQuickShaderEffectSource;
+class QQuickRotation;
+QT_END_NAMESPACE
+
+WAYLIB_SERVER_USE_NAMESPACE
+
+class QmlEngine;
+class SurfaceWrapper;
+
+// Drives the geometry/open/close animations of a SurfaceWrapper from c++, the
+// curves match the former GeometryAnimation, NewAnimation, LayerShellAnimation
+// and LaunchpadAnimation qml components.
+class SurfaceAnimator : public QQuickItem
+{
+    Q_OBJECT
+
+public:
+    enum class Effect
+    {
+        None,
+        Geometry,
+        Window,
+        LayerShell,
+        Launchpad,
+    };
+    Q_ENUM(Effect)
+
+    explicit SurfaceAnimator(SurfaceWrapper *surface, QmlEngine *engine);
+    ~SurfaceAnimator() override;
+
+    Effect effect() const;
+    bool isRunning() const;
+
+    void startGeometry(const QRectF &fromGeometry,
+                       const QRectF &toGeometry,
+                       QQuickItem *parent,
+                       bool enableBlur);
+    void setTargetGeometry(const QRectF &toGeometry);
+    void startWindow(bool show, QQuickItem *parent, bool enableBlur);
+    void startLayerShell(bool show,
+                         WLayerSurface::AnchorType position,
+                         QQuickItem *parent,
+                         bool enableBlur);
+    void startLaunchpad(bool show, QQuickItem *parent);
+    void stop();
+
+Q_SIGNALS:
+    void ready();
+    void finished();
+
+private:
+    void prepare(Effect effect, QQuickItem *parent, int duration, bool enableBlur);
+    QQuickShaderEffectSource *createEffectSource(bool live, bool hideSource);
+    void updateProgress(const QVariant &value);
+    void updateGeometry(qreal progress);
+    void updateWindow(qreal progress);
+    void updateLayerShell(qreal progress);
+    void updateLaunchpad(qreal progress);
+    void onAnimationFinished();
+    void cleanup();
+
+    SurfaceWrapper *m_surface;
+    QmlEngine *m_engine;
+    QVariantAnimation *m_animation;
+    QQuickRotation *m_rotation;
+    QPointer<QQuickShaderEffectSource> m_content;
+    QPointer<QQuickShaderEffectSource> m_snapshot;
+    QPointer<QQuickItem> m_blur;
+    QEasingCurve m_outCubic{ QEasingCurve::OutCubic };
+    QEasingCurve m_outExpo{ QEasingCurve::OutExpo };
+
+    Effect m_effect = Effect::None;
+    QRectF m_fromGeometry;
+    QRectF m_toGeometry;
+    QRectF m_snapshotRect;
+    WLayerSurface::AnchorType m_position = WLayerSurface::AnchorType::None;
+    bool m_show = true;
+};
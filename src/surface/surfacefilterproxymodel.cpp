@@ -32,20 +32,12 @@ void SurfaceFilterProxyModel::setActiveIndex(int index)
 bool SurfaceFilterProxyModel::filterAcceptsRow(int source_row,
                                                const QModelIndex &source_parent) const
 {
-    QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
-    SurfaceWrapper *surface = sourceModel()->data(index).value<SurfaceWrapper *>();
-    auto wsurface = surface->shellSurface();
-    Q_ASSERT(wsurface);
-
-    if (m_filterAppId.isEmpty()) {
+    if (m_filterAppId.isEmpty())
         return true;
-    }
 
-    if (surface) {
-        return wsurface->appId() == m_filterAppId;
-    }
-
-    return false;
+    QModelIndex index = sourceModel()->index(source_row, 0, source_parent);
+    SurfaceWrapper *surface = sourceModel()->data(index).value<SurfaceWrapper *>();
+    return surface && surface->appId() == m_filterAppId;
 }
 
 bool SurfaceFilterProxyModel::lessThan(const QModelIndex &source_left,
@@ -56,13 +48,8 @@ bool SurfaceFilterProxyModel::lessThan(const QModelIndex &source_left,
     SurfaceWrapper *right_surface = sourceModel()->data(source_right).value<SurfaceWrapper *>();
 
     if (model && left_surface && right_surface) {
-        int left_index = model->findActivedSurfaceHistoryIndex(left_surface);
-        int right_index = model->findActivedSurfaceHistoryIndex(right_surface);
-
-        if (left_index > right_index)
-            return true;
-        else
-            return false;
+        // Earlier activated first, never activated surfaces have stamp 0
+        return model->activationStamp(left_surface) < model->activationStamp(right_surface);
     }
 
     return QSortFilterProxyModel::lessThan(source_left, source_right);
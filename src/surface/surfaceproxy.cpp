@@ -173,7 +173,7 @@ void SurfaceProxy::onSourceRadiusChanged()
 {
     m_proxySurface->setRadius(radius() / m_proxySurface->scale());
     if (m_shadow)
-        m_shadow->setProperty("radius", radius());
+        m_shadow->setProperty("cornerRadius", radius());
     if (m_radius < 0)
         Q_EMIT radiusChanged();
 }
@@ -193,7 +193,7 @@ void SurfaceProxy::setRadius(qreal newRadius)
     if (m_proxySurface) {
         m_proxySurface->setRadius(radius() / m_proxySurface->scale());
         if (m_shadow)
-            m_shadow->setProperty("radius", radius());
+            m_shadow->setProperty("cornerRadius", radius());
     }
 
     Q_EMIT radiusChanged();
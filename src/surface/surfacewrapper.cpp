@@ -6,6 +6,7 @@
 #include "config/treelandconfig.h"
 #include "core/qmlengine.h"
 #include "output/output.h"
+#include "surface/surfaceanimator.h"
 #include "workspace/workspace.h"
 
 #include <winputpopupsurfaceitem.h>
@@ -22,6 +23,8 @@
 
 #include <qwlayershellv1.h>
 
+#include <QTimer>
+
 #define OPEN_ANIMATION 1
 #define CLOSE_ANIMATION 2
 #define ALWAYSONTOPLAYER 1
@@ -56,6 +59,11 @@ SurfaceWrapper::SurfaceWrapper(QmlEngine *qmlEngine,
     , m_hideByLockScreen(false)
     , m_confirmHideByLockScreen(false)
     , m_blur(false)
+    , m_decorationRealized(false)
+    , m_titleBarPending(false)
+    , m_geometryDirty(false)
+    , m_boundingRectDirty(false)
+    , m_clipRectDirty(false)
 {
     QQmlEngine::setContextForObject(this, qmlEngine->rootContext());
 
@@ -131,6 +139,10 @@ SurfaceWrapper::SurfaceWrapper(QmlEngine *qmlEngine,
     shellSurface->surface()->safeConnect(&WSurface::mappedChanged,
                                          this,
                                          &SurfaceWrapper::onMappedChanged);
+    shellSurface->safeConnect(&WToplevelSurface::appIdChanged,
+                              this,
+                              &SurfaceWrapper::updateAppId);
+    m_appId = shellSurface->appId();
 
     connect(m_surfaceItem,
             &WSurfaceItem::boundingRectChanged,
@@ -296,6 +308,11 @@ WToplevelSurface *SurfaceWrapper::shellSurface() const
     return m_shellSurface;
 }
 
+const QString &SurfaceWrapper::appId() const
+{
+    return m_appId;
+}
+
 WSurfaceItem *SurfaceWrapper::surfaceItem() const
 {
     return m_surfaceItem;
@@ -326,8 +343,9 @@ void SurfaceWrapper::moveNormalGeometryInOutput(const QPointF &position)
     setNormalGeometry(QRectF(position, m_normalGeometry.size()));
     if (isNormal()) {
         setPosition(position);
-    } else if (m_pendingState == State::Normal && m_geometryAnimation) {
-        m_geometryAnimation->setProperty("toGeometry", m_normalGeometry);
+    } else if (m_pendingState == State::Normal && isAnimationRunning()) {
+        m_pendingGeometry = m_normalGeometry;
+        m_geometryAnimation->setTargetGeometry(m_normalGeometry);
     }
 }
 
@@ -359,8 +377,9 @@ void SurfaceWrapper::setMaximizedGeometry(const QRectF &newMaximizedGeometry)
     if (m_surfaceState == State::Maximized) {
         setPosition(newMaximizedGeometry.topLeft());
         resize(newMaximizedGeometry.size());
-    } else if (m_pendingState == State::Maximized && m_geometryAnimation) {
-        m_geometryAnimation->setProperty("targetGeometry", newMaximizedGeometry);
+    } else if (m_pendingState == State::Maximized && isAnimationRunning()) {
+        m_pendingGeometry = newMaximizedGeometry;
+        m_geometryAnimation->setTargetGeometry(newMaximizedGeometry);
     }
 
     Q_EMIT maximizedGeometryChanged();
@@ -386,8 +405,9 @@ void SurfaceWrapper::setFullscreenGeometry(const QRectF &newFullscreenGeometry)
     if (m_surfaceState == State::Fullscreen) {
         setPosition(newFullscreenGeometry.topLeft());
         resize(newFullscreenGeometry.size());
-    } else if (m_pendingState == State::Fullscreen && m_geometryAnimation) {
-        m_geometryAnimation->setProperty("targetGeometry", newFullscreenGeometry);
+    } else if (m_pendingState == State::Fullscreen && isAnimationRunning()) {
+        m_pendingGeometry = newFullscreenGeometry;
+        m_geometryAnimation->setTargetGeometry(newFullscreenGeometry);
     }
 
     Q_EMIT fullscreenGeometryChanged();
@@ -521,7 +541,7 @@ void SurfaceWrapper::setSurfaceState(State newSurfaceState)
     if (m_wrapperAboutToRemove)
         return;
 
-    if (m_geometryAnimation)
+    if (isAnimationRunning())
         return;
 
     if (m_surfaceState == newSurfaceState)
@@ -549,10 +569,6 @@ void SurfaceWrapper::setSurfaceState(State newSurfaceState)
     if (targetGeometry.isValid()) {
         startStateChangeAnimation(newSurfaceState, targetGeometry);
     } else {
-        if (m_geometryAnimation) {
-            m_geometryAnimation->deleteLater();
-        }
-
         doSetSurfaceState(newSurfaceState);
     }
 }
@@ -584,12 +600,12 @@ bool SurfaceWrapper::isTiling() const
 
 bool SurfaceWrapper::isAnimationRunning() const
 {
-    return m_geometryAnimation;
+    return m_geometryAnimation && m_geometryAnimation->isRunning();
 }
 
 bool SurfaceWrapper::isWindowAnimationRunning() const
 {
-    return !m_windowAnimation.isNull();
+    return m_windowAnimation && m_windowAnimation->isRunning();
 }
 
 void SurfaceWrapper::markWrapperToRemoved()
@@ -645,55 +661,147 @@ void SurfaceWrapper::setNoDecoration(bool newNoDecoration)
     if (m_noDecoration == newNoDecoration)
         return;
 
+    if (isVisible())
+        realizeDecorations();
+
     m_noDecoration = newNoDecoration;
     if (m_titleBarState == TitleBarState::Default)
         updateTitleBar();
 
     if (m_noDecoration) {
-        Q_ASSERT(m_decoration);
-        m_decoration->deleteLater();
-        m_decoration = nullptr;
-    } else {
-        Q_ASSERT(!m_decoration);
-        m_decoration = m_engine->createDecoration(this, this);
-        m_decoration->stackBefore(m_surfaceItem);
-        connect(m_decoration, &QQuickItem::xChanged, this, &SurfaceWrapper::updateBoundingRect);
-        connect(m_decoration, &QQuickItem::yChanged, this, &SurfaceWrapper::updateBoundingRect);
-        connect(m_decoration, &QQuickItem::widthChanged, this, &SurfaceWrapper::updateBoundingRect);
-        connect(m_decoration,
-                &QQuickItem::heightChanged,
-                this,
-                &SurfaceWrapper::updateBoundingRect);
+        if (m_decoration) {
+            m_decoration->deleteLater();
+            m_decoration = nullptr;
+        }
+    } else if (m_decorationRealized) {
+        createDecoration();
     }
 
     updateBoundingRect();
     Q_EMIT noDecorationChanged();
 }
 
+void SurfaceWrapper::createDecoration()
+{
+    Q_ASSERT(!m_decoration);
+    m_decoration = m_engine->createDecoration(this, this);
+    m_decoration->stackBefore(m_surfaceItem);
+    connect(m_decoration, &QQuickItem::xChanged, this, &SurfaceWrapper::updateBoundingRect);
+    connect(m_decoration, &QQuickItem::yChanged, this, &SurfaceWrapper::updateBoundingRect);
+    connect(m_decoration, &QQuickItem::widthChanged, this, &SurfaceWrapper::updateBoundingRect);
+    connect(m_decoration, &QQuickItem::heightChanged, this, &SurfaceWrapper::updateBoundingRect);
+}
+
 void SurfaceWrapper::updateTitleBar()
 {
     if (m_wrapperAboutToRemove)
         return;
 
-    if (noTitleBar() == !m_titleBar)
+    if (isVisible())
+        realizeDecorations();
+
+    const bool hasTitleBar = m_titleBar || m_titleBarPending;
+    if (noTitleBar() == !hasTitleBar)
         return;
 
-    if (m_titleBar) {
-        m_titleBar->deleteLater();
-        m_titleBar = nullptr;
+    if (hasTitleBar) {
+        if (m_titleBar) {
+            m_titleBar->deleteLater();
+            m_titleBar = nullptr;
+        }
+        m_titleBarPending = false;
         m_surfaceItem->setTopPadding(0);
+    } else if (m_decorationRealized) {
+        createTitleBar();
     } else {
-        m_titleBar = m_engine->createTitleBar(this, m_surfaceItem);
-        m_titleBar->setZ(static_cast<int>(WSurfaceItem::ZOrder::ContentItem));
-        m_surfaceItem->setTopPadding(m_titleBar->height());
-        connect(m_titleBar, &QQuickItem::heightChanged, this, [this] {
-            m_surfaceItem->setTopPadding(m_titleBar->height());
-        });
+        // Reserve the titlebar space so the geometry doesn't change once it's created
+        m_titleBarPending = true;
+        m_surfaceItem->setTopPadding(TreelandConfig::ref().windowTitlebarHeight());
     }
 
     Q_EMIT noTitleBarChanged();
 }
 
+void SurfaceWrapper::createTitleBar()
+{
+    Q_ASSERT(!m_titleBar);
+    m_titleBarPending = false;
+    m_titleBar = m_engine->createTitleBar(this, m_surfaceItem);
+    m_titleBar->setZ(static_cast<int>(WSurfaceItem::ZOrder::ContentItem));
+    m_surfaceItem->setTopPadding(m_titleBar->height());
+    connect(m_titleBar, &QQuickItem::heightChanged, this, [this] {
+        m_surfaceItem->setTopPadding(m_titleBar->height());
+    });
+}
+
+void SurfaceWrapper::realizeDecorations()
+{
+    if (m_decorationReleaseTimer)
+        m_decorationReleaseTimer->stop();
+
+    if (m_decorationRealized || m_wrapperAboutToRemove)
+        return;
+
+    m_decorationRealized = true;
+    if (!m_noDecoration && !m_decoration) {
+        createDecoration();
+        updateBoundingRect();
+        Q_EMIT noDecorationChanged();
+    }
+    if (m_titleBarPending) {
+        createTitleBar();
+        Q_EMIT noTitleBarChanged();
+    }
+}
+
+void SurfaceWrapper::releaseDecorations()
+{
+    if (!m_decorationRealized || isVisible() || m_wrapperAboutToRemove)
+        return;
+
+    // Animations may still render this wrapper through a texture proxy
+    if (isAnimationRunning() || isWindowAnimationRunning() || m_minimizeAnimation) {
+        m_decorationReleaseTimer->start();
+        return;
+    }
+
+    m_decorationRealized = false;
+    if (m_decoration) {
+        m_decoration->deleteLater();
+        m_decoration = nullptr;
+        updateBoundingRect();
+        Q_EMIT noDecorationChanged();
+    }
+    if (m_titleBar) {
+        // Keep the top padding, the titlebar is recreated with the same height
+        m_titleBar->disconnect(this);
+        m_titleBar->deleteLater();
+        m_titleBar = nullptr;
+        m_titleBarPending = true;
+        Q_EMIT noTitleBarChanged();
+    }
+}
+
+void SurfaceWrapper::scheduleDecorationRelease()
+{
+    if (!m_decorationRealized || m_isProxy)
+        return;
+
+    const uint delay = TreelandConfig::ref().decorationReleaseDelay();
+    if (delay == 0)
+        return;
+
+    if (!m_decorationReleaseTimer) {
+        m_decorationReleaseTimer = new QTimer(this);
+        m_decorationReleaseTimer->setSingleShot(true);
+        connect(m_decorationReleaseTimer,
+                &QTimer::timeout,
+                this,
+                &SurfaceWrapper::releaseDecorations);
+    }
+    m_decorationReleaseTimer->start(delay);
+}
+
 void SurfaceWrapper::setBoundedRect(const QRectF &newBoundedRect)
 {
     if (m_boundedRect == newBoundedRect)
@@ -722,6 +830,15 @@ void SurfaceWrapper::updateVisible()
                && m_socketEnabled && m_hideByshowDesk && !m_confirmHideByLockScreen);
 }
 
+void SurfaceWrapper::updateAppId()
+{
+    const QString appId = m_shellSurface->appId();
+    if (m_appId == appId)
+        return;
+    m_appId = appId;
+    Q_EMIT appIdChanged();
+}
+
 void SurfaceWrapper::updateSubSurfaceStacking()
 {
     SurfaceWrapper *lastSurface = this;
@@ -746,7 +863,7 @@ void SurfaceWrapper::geometryChange(const QRectF &newGeo, const QRectF &oldGeome
     if (m_container && m_container->filterSurfaceGeometryChanged(this, newGeometry, oldGeometry))
         return;
 
-    if (isNormal() && !m_geometryAnimation) {
+    if (isNormal() && !isAnimationRunning()) {
         setNormalGeometry(newGeometry);
     }
 
@@ -754,11 +871,39 @@ void SurfaceWrapper::geometryChange(const QRectF &newGeo, const QRectF &oldGeome
         resize(newGeometry.size());
     }
 
-    Q_EMIT geometryChanged();
     QQuickItem::geometryChange(newGeometry, oldGeometry);
+
+    // Everything derived from the geometry is flushed once before the next frame
+    m_geometryDirty = true;
+    m_clipRectDirty = true;
     if (newGeometry.size() != oldGeometry.size())
+        m_boundingRectDirty = true;
+    if (window())
+        polish();
+    else
+        flushGeometryChanges();
+}
+
+void SurfaceWrapper::updatePolish()
+{
+    QQuickItem::updatePolish();
+    flushGeometryChanges();
+}
+
+void SurfaceWrapper::flushGeometryChanges()
+{
+    if (m_boundingRectDirty) {
+        m_boundingRectDirty = false;
         updateBoundingRect();
-    updateClipRect();
+    }
+    if (m_clipRectDirty) {
+        m_clipRectDirty = false;
+        updateClipRect();
+    }
+    if (m_geometryDirty) {
+        m_geometryDirty = false;
+        Q_EMIT geometryChanged();
+    }
 }
 
 void SurfaceWrapper::createNewOrClose(uint direction)
@@ -766,18 +911,28 @@ void SurfaceWrapper::createNewOrClose(uint direction)
     if (!m_windowAnimationEnabled)
         return;
 
-    if (m_windowAnimation)
+    if (isWindowAnimationRunning())
         return;
 
     if (m_container.isNull())
         return;
 
+    if (!m_windowAnimation) {
+        m_windowAnimation = new SurfaceAnimator(this, m_engine);
+        connect(m_windowAnimation, &SurfaceAnimator::finished, this, [this] {
+            if (m_windowAnimationDirection == OPEN_ANIMATION)
+                onShowAnimationFinished();
+            else
+                onHideAnimationFinished();
+        });
+    }
+
+    const bool show = direction == OPEN_ANIMATION;
     switch (m_type) {
     case Type::XdgToplevel:
         [[fallthrough]];
     case Type::XWayland: {
-        m_windowAnimation = m_engine->createNewAnimation(this, container(), direction);
-        m_windowAnimation->setProperty("enableBlur", m_blur);
+        m_windowAnimation->startWindow(show, container(), m_blur);
     } break;
     case Type::Layer: {
         auto scope = QString(static_cast<WLayerSurfaceItem *>(m_surfaceItem)
@@ -788,11 +943,9 @@ void SurfaceWrapper::createNewOrClose(uint direction)
         auto *surface = qobject_cast<WLayerSurface *>(m_shellSurface);
         auto anchor = surface->getExclusiveZoneEdge();
         if (scope == "dde-shell/launchpad") {
-            m_windowAnimation = m_engine->createLaunchpadAnimation(this, direction, m_container);
+            m_windowAnimation->startLaunchpad(show, m_container);
         } else if (anchor != WLayerSurface::AnchorType::None) {
-            m_windowAnimation = m_engine->createLayerShellAnimation(this, container(), direction);
-            m_windowAnimation->setProperty("position", QVariant::fromValue(anchor));
-            m_windowAnimation->setProperty("enableBlur", m_blur);
+            m_windowAnimation->startLayerShell(show, anchor, container(), m_blur);
         } else {
             // NOTE: missing fullscreen window animation, so hide window now.
             if (m_hideByLockScreen) {
@@ -808,23 +961,8 @@ void SurfaceWrapper::createNewOrClose(uint direction)
         break;
     }
 
-    if (m_windowAnimation) {
-        bool ok = false;
-        if (direction == OPEN_ANIMATION) {
-            ok = connect(m_windowAnimation,
-                         SIGNAL(finished()),
-                         this,
-                         SLOT(onShowAnimationFinished()));
-        } else {
-            ok = connect(m_windowAnimation,
-                         SIGNAL(finished()),
-                         this,
-                         SLOT(onHideAnimationFinished()));
-        }
-        Q_ASSERT(ok);
-        ok = QMetaObject::invokeMethod(m_windowAnimation, "start");
-        Q_ASSERT(ok);
-
+    if (isWindowAnimationRunning()) {
+        m_windowAnimationDirection = direction;
         Q_EMIT windowAnimationRunningChanged();
     }
 }
@@ -833,6 +971,11 @@ void SurfaceWrapper::itemChange(ItemChange change, const ItemChangeData &data)
 {
     if (change == ItemSceneChange) {
         updateSurfaceSizeRatio();
+    } else if (change == ItemVisibleHasChanged) {
+        if (data.boolValue)
+            realizeDecorations();
+        else
+            scheduleDecorationRelease();
     }
 
     return QQuickItem::itemChange(change, data);
@@ -899,7 +1042,7 @@ void SurfaceWrapper::onAnimationReady()
 
     if (!resize(m_pendingGeometry.size())) {
         // abort change state if resize failed
-        m_geometryAnimation->deleteLater();
+        m_geometryAnimation->stop();
         return;
     }
 
@@ -910,37 +1053,36 @@ void SurfaceWrapper::onAnimationReady()
 void SurfaceWrapper::onAnimationFinished()
 {
     setXwaylandPositionFromSurface(true);
-    Q_ASSERT(m_geometryAnimation);
-    m_geometryAnimation->deleteLater();
 }
 
 bool SurfaceWrapper::startStateChangeAnimation(State targetState, const QRectF &targetGeometry)
 {
-    if (m_geometryAnimation) // animation running
+    if (isAnimationRunning())
         return false;
 
-    m_geometryAnimation =
-        m_engine->createGeometryAnimation(this, geometry(), targetGeometry, container());
-    m_geometryAnimation->setProperty("enableBlur", m_blur);
+    if (!m_geometryAnimation) {
+        m_geometryAnimation = new SurfaceAnimator(this, m_engine);
+        connect(m_geometryAnimation,
+                &SurfaceAnimator::ready,
+                this,
+                &SurfaceWrapper::onAnimationReady);
+        connect(m_geometryAnimation,
+                &SurfaceAnimator::finished,
+                this,
+                &SurfaceWrapper::onAnimationFinished);
+    }
+
     m_pendingState = targetState;
     m_pendingGeometry = targetGeometry;
-    bool ok = connect(m_geometryAnimation, SIGNAL(ready()), this, SLOT(onAnimationReady()));
-    Q_ASSERT(ok);
-    ok = connect(m_geometryAnimation, SIGNAL(finished()), this, SLOT(onAnimationFinished()));
-    Q_ASSERT(ok);
 
     setXwaylandPositionFromSurface(false);
-    ok = QMetaObject::invokeMethod(m_geometryAnimation, "start");
-    Q_ASSERT(ok);
-    return ok;
+    m_geometryAnimation->startGeometry(geometry(), targetGeometry, container(), m_blur);
+    return true;
 }
 
 void SurfaceWrapper::onWindowAnimationFinished()
 {
     Q_ASSERT(m_windowAnimation);
-    m_windowAnimation->deleteLater();
-    m_windowAnimation = nullptr;
-
     Q_EMIT windowAnimationRunningChanged();
 
     if (m_wrapperAboutToRemove) {
@@ -1029,6 +1171,7 @@ void SurfaceWrapper::setHideByShowDesk(bool show)
         return;
 
     m_hideByshowDesk = show;
+    updateVisible();
 }
 
 void SurfaceWrapper::setHideByLockScreen(bool hide)
@@ -1043,31 +1186,6 @@ void SurfaceWrapper::setHideByLockScreen(bool hide)
     onMappedChanged();
 }
 
-void SurfaceWrapper::onShowDesktopAnimationFinished()
-{
-    Q_ASSERT(m_showDesktopAnimation);
-    m_showDesktopAnimation->deleteLater();
-    updateVisible();
-}
-
-void SurfaceWrapper::startShowDesktopAnimation(bool show)
-{
-
-    if (m_showDesktopAnimation) {
-        m_showDesktopAnimation->deleteLater();
-    }
-
-    setHideByShowDesk(show);
-    m_showDesktopAnimation = m_engine->createShowDesktopAnimation(this, container(), show);
-    bool ok = connect(m_showDesktopAnimation,
-                      SIGNAL(finished()),
-                      this,
-                      SLOT(onShowDesktopAnimationFinished()));
-    Q_ASSERT(ok);
-    ok = QMetaObject::invokeMethod(m_showDesktopAnimation, "start");
-    Q_ASSERT(ok);
-}
-
 qreal SurfaceWrapper::radius() const
 {
     // TODO: move to dconfig
@@ -1220,6 +1338,7 @@ bool SurfaceWrapper::stackBefore(QQuickItem *item)
     } while (false);
 
     updateSubSurfaceStacking();
+    Q_EMIT stackingChanged();
     return true;
 }
 
@@ -1265,6 +1384,7 @@ bool SurfaceWrapper::stackAfter(QQuickItem *item)
     } while (false);
 
     updateSubSurfaceStacking();
+    Q_EMIT stackingChanged();
     return true;
 }
 
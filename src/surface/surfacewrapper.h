@@ -14,6 +14,8 @@ WAYLIB_SERVER_USE_NAMESPACE
 
 class QmlEngine;
 class Output;
+class QTimer;
+class SurfaceAnimator;
 class SurfaceContainer;
 
 class SurfaceWrapper : public QQuickItem
@@ -118,6 +120,8 @@ public:
 
     WSurface *surface() const;
     WToplevelSurface *shellSurface() const;
+    // Cached from the shell surface, updated before appIdChanged
+    const QString &appId() const;
     WSurfaceItem *surfaceItem() const;
     bool resize(const QSizeF &size);
 
@@ -241,6 +245,8 @@ public:
     bool acceptKeyboardFocus() const;
     void setAcceptKeyboardFocus(bool accept);
 
+    void flushGeometryChanges();
+
 public Q_SLOTS:
     // for titlebar
     void requestMinimize(bool onAnimation = true);
@@ -299,6 +305,9 @@ Q_SIGNALS:
     void coverEnabledChanged();
     void aboutToBeInvalidated();
     void acceptKeyboardFocusChanged();
+    void appIdChanged();
+    // Emitted by stackBefore() and stackAfter(), QQuickItem has no signal for it
+    void stackingChanged();
 
 private:
     ~SurfaceWrapper() override;
@@ -310,29 +319,34 @@ private:
     void setActivate(bool activate);
     void setNormalGeometry(const QRectF &newNormalGeometry);
     void updateTitleBar();
+    void createTitleBar();
+    void createDecoration();
+    void realizeDecorations();
+    void releaseDecorations();
+    void scheduleDecorationRelease();
     void setBoundedRect(const QRectF &newBoundedRect);
     void setContainer(SurfaceContainer *newContainer);
     void setVisibleDecoration(bool newVisibleDecoration);
     void updateBoundingRect();
     void updateVisible();
+    void updateAppId();
     void updateSubSurfaceStacking();
     void updateClipRect();
     void geometryChange(const QRectF &newGeo, const QRectF &oldGeometry) override;
+    void updatePolish() override;
     void createNewOrClose(uint direction);
     void itemChange(ItemChange change, const ItemChangeData &data) override;
 
     void doSetSurfaceState(State newSurfaceState);
-    Q_SLOT void onAnimationReady();
-    Q_SLOT void onAnimationFinished();
+    void onAnimationReady();
+    void onAnimationFinished();
     bool startStateChangeAnimation(SurfaceWrapper::State targetState, const QRectF &targetGeometry);
     void onWindowAnimationFinished();
-    Q_SLOT void onShowAnimationFinished();
-    Q_SLOT void onHideAnimationFinished();
+    void onShowAnimationFinished();
+    void onHideAnimationFinished();
     void updateExplicitAlwaysOnTop();
     void startMinimizeAnimation(const QRectF &iconGeometry, uint direction);
     Q_SLOT void onMinimizeAnimationFinished();
-    void startShowDesktopAnimation(bool show);
-    Q_SLOT void onShowDesktopAnimationFinished();
     void updateHasActiveCapability(ActiveControlState state, bool value);
 
     // wayland set by treeland-dde-shell, x11 set by bypassManager/windowTypes
@@ -349,8 +363,9 @@ private:
     WSurfaceItem *m_surfaceItem = nullptr;
     QPointer<QQuickItem> m_titleBar;
     QPointer<QQuickItem> m_decoration;
-    QPointer<QQuickItem> m_geometryAnimation;
+    SurfaceAnimator *m_geometryAnimation = nullptr;
     QPointer<QQuickItem> m_coverContent;
+    QTimer *m_decorationReleaseTimer = nullptr;
     QRectF m_boundedRect;
     QRectF m_normalGeometry;
     QRectF m_maximizedGeometry;
@@ -361,9 +376,9 @@ private:
     QPointF m_positionInOwnsOutput;
     SurfaceWrapper::State m_pendingState;
     QRectF m_pendingGeometry;
-    QPointer<QQuickItem> m_windowAnimation;
+    SurfaceAnimator *m_windowAnimation = nullptr;
+    uint m_windowAnimationDirection = 0;
     QPointer<QQuickItem> m_minimizeAnimation;
-    QPointer<QQuickItem> m_showDesktopAnimation;
     Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(SurfaceWrapper,
                                          SurfaceWrapper::State,
                                          m_previousSurfaceState,
@@ -406,8 +421,16 @@ private:
     uint m_hideByLockScreen : 1;
     uint m_confirmHideByLockScreen : 1;
     uint m_blur : 1;
+    // decorations and titlebar are created on first visibility
+    uint m_decorationRealized : 1;
+    uint m_titleBarPending : 1;
+    // geometry derived updates pending for the next polish
+    uint m_geometryDirty : 1;
+    uint m_boundingRectDirty : 1;
+    uint m_clipRectDirty : 1;
     SurfaceRole m_surfaceRole = SurfaceRole::Normal;
     quint32 m_autoPlaceYOffset = 0;
+    QString m_appId;
     QPoint m_clientRequstPos;
 
     bool m_socketEnabled{ false };
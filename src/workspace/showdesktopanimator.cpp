@@ -0,0 +1,109 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "workspace/showdesktopanimator.h"
+
+#include "core/qmlengine.h"
+#include "seat/helper.h"
+
+#include <QEasingCurve>
+#include <QQmlEngine>
+#include <QVariantAnimation>
+
+#include <private/qquickshadereffectsource_p.h>
+
+ShowDesktopAnimator::ShowDesktopAnimator(QQuickItem *workspace, QmlEngine *engine)
+    : QQuickItem(workspace->parentItem())
+    , m_workspace(workspace)
+    , m_animation(new QVariantAnimation(this))
+{
+    QQmlEngine::setContextForObject(this, engine->rootContext());
+    setVisible(false);
+    setZ(workspace->z());
+    stackAfter(workspace);
+
+    m_animation->setStartValue(0.0);
+    m_animation->setEndValue(1.0);
+    m_animation->setEasingCurve(QEasingCurve::OutExpo);
+    connect(m_animation,
+            &QVariantAnimation::valueChanged,
+            this,
+            &ShowDesktopAnimator::updateProgress);
+    connect(m_animation,
+            &QVariantAnimation::finished,
+            this,
+            &ShowDesktopAnimator::onAnimationFinished);
+}
+
+ShowDesktopAnimator::~ShowDesktopAnimator()
+{
+    m_animation->stop();
+    cleanup();
+}
+
+bool ShowDesktopAnimator::isRunning() const
+{
+    return m_snapshot;
+}
+
+void ShowDesktopAnimator::start(bool show)
+{
+    stop();
+    m_show = show;
+
+    // The windows are shown before the snapshot is taken, the snapshot hides the
+    // workspace so they don't appear until faded in
+    if (show)
+        Q_EMIT applyState(true);
+
+    setPosition(m_workspace->position());
+    setSize(m_workspace->size());
+    setOpacity(show ? 0.0 : 1.0);
+    setVisible(true);
+
+    m_snapshot = new QQuickShaderEffectSource(this);
+    QQmlEngine::setContextForObject(m_snapshot, qmlContext(this));
+    m_snapshot->setLive(false);
+    m_snapshot->setHideSource(true);
+    m_snapshot->setSourceItem(m_workspace);
+    m_snapshot->setSize(size());
+
+    m_animation->setDuration(500 * Helper::instance()->animationSpeed());
+    m_animation->start();
+}
+
+void ShowDesktopAnimator::stop()
+{
+    if (!isRunning())
+        return;
+
+    m_animation->stop();
+    onAnimationFinished();
+}
+
+void ShowDesktopAnimator::updateProgress(const QVariant &value)
+{
+    const qreal progress = value.toReal();
+    setOpacity(m_show ? progress : 1.0 - progress);
+}
+
+void ShowDesktopAnimator::onAnimationFinished()
+{
+    // Hide the windows before the workspace itself is shown again
+    if (!m_show)
+        Q_EMIT applyState(false);
+    cleanup();
+    Q_EMIT finished();
+}
+
+void ShowDesktopAnimator::cleanup()
+{
+    setVisible(false);
+
+    if (m_snapshot) {
+        // Release hideSource right now, the item itself goes with the next event loop
+        m_snapshot->setSourceItem(nullptr);
+        m_snapshot->deleteLater();
+        m_snapshot = nullptr;
+    }
+}
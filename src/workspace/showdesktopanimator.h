@@ -0,0 +1,44 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+#pragma once
+
+#include <QPointer>
+#include <QQuickItem>
+
+QT_BEGIN_NAMESPACE
+class QVariantAnimation;
+class QQuickShaderEffectSource;
+QT_END_NAMESPACE
+
+class QmlEngine;
+
+// Fades the windows of the workspace in or out for show desktop through a single
+// snapshot of the workspace container, so the cost does not grow with the window count.
+// applyState is emitted once per transition: before fading in, and after fading out.
+class ShowDesktopAnimator : public QQuickItem
+{
+    Q_OBJECT
+
+public:
+    explicit ShowDesktopAnimator(QQuickItem *workspace, QmlEngine *engine);
+    ~ShowDesktopAnimator() override;
+
+    bool isRunning() const;
+    // show is true when the windows come back
+    void start(bool show);
+    void stop();
+
+Q_SIGNALS:
+    void applyState(bool show);
+    void finished();
+
+private:
+    void updateProgress(const QVariant &value);
+    void onAnimationFinished();
+    void cleanup();
+
+    QQuickItem *m_workspace;
+    QVariantAnimation *m_animation;
+    QPointer<QQuickShaderEffectSource> m_snapshot;
+    bool m_show = true;
+};
@@ -6,9 +6,39 @@
 #include "seat/helper.h"
 #include "surface/surfacewrapper.h"
 
+void ActivationHistory::push(SurfaceWrapper *surface)
+{
+    // Shared by all workspaces, stamps copied to a new workspace stay comparable
+    static quint64 nextStamp = 0;
+
+    remove(surface);
+    const quint64 stamp = ++nextStamp;
+    m_stamps.insert(surface, stamp);
+    m_surfaces.emplace(stamp, surface);
+}
+
+void ActivationHistory::remove(SurfaceWrapper *surface)
+{
+    const quint64 stamp = m_stamps.take(surface);
+    if (stamp)
+        m_surfaces.erase(stamp);
+}
+
+quint64 ActivationHistory::stamp(SurfaceWrapper *surface) const
+{
+    return m_stamps.value(surface);
+}
+
+SurfaceWrapper *ActivationHistory::recent(int index) const
+{
+    if (index < 0 || index >= int(m_surfaces.size()))
+        return nullptr;
+    return std::next(m_surfaces.rbegin(), index)->second;
+}
+
 WorkspaceModel::WorkspaceModel(QObject *parent,
                                int id,
-                               std::forward_list<SurfaceWrapper *> activedSurfaceHistory)
+                               const ActivationHistory &activedSurfaceHistory)
     : SurfaceListModel(parent)
     , m_id(id)
     , m_activedSurfaceHistory(activedSurfaceHistory)
@@ -90,37 +120,22 @@ void WorkspaceModel::removeSurface(SurfaceWrapper *surface)
 
 SurfaceWrapper *WorkspaceModel::latestActiveSurface() const
 {
-    if (m_activedSurfaceHistory.empty())
-        return nullptr;
-    return m_activedSurfaceHistory.front();
+    return m_activedSurfaceHistory.recent(0);
 }
 
 SurfaceWrapper *WorkspaceModel::activePenultimateWindow() const
 {
-    if (m_activedSurfaceHistory.empty())
-        return nullptr;
-
-    auto first = m_activedSurfaceHistory.begin();
-    auto second = std::next(first);
-    if (second == m_activedSurfaceHistory.end()) {
-        return nullptr;
-    }
-
-    return *second;
+    return m_activedSurfaceHistory.recent(1);
 }
 
 SurfaceWrapper *WorkspaceModel::findNextActivedSurface() const
 {
-    auto it = m_activedSurfaceHistory.begin();
-    if (it == m_activedSurfaceHistory.end() || ++it == m_activedSurfaceHistory.end())
-        return nullptr;
-    return *it;
+    return m_activedSurfaceHistory.recent(1);
 }
 
 void WorkspaceModel::pushActivedSurface(SurfaceWrapper *surface)
 {
-    m_activedSurfaceHistory.remove(surface);
-    m_activedSurfaceHistory.push_front(surface);
+    m_activedSurfaceHistory.push(surface);
 }
 
 void WorkspaceModel::removeActivedSurface(SurfaceWrapper *surface)
@@ -128,14 +143,7 @@ void WorkspaceModel::removeActivedSurface(SurfaceWrapper *surface)
     m_activedSurfaceHistory.remove(surface);
 }
 
-int WorkspaceModel::findActivedSurfaceHistoryIndex(SurfaceWrapper *surface) const
+quint64 WorkspaceModel::activationStamp(SurfaceWrapper *surface) const
 {
-    int index = 0;
-    for (auto it = m_activedSurfaceHistory.begin(); it != m_activedSurfaceHistory.end();
-         ++it, ++index) {
-        if (*it == surface) {
-            return index;
-        }
-    }
-    return index;
+    return m_activedSurfaceHistory.stamp(surface);
 }
@@ -5,11 +5,30 @@
 
 #include "surface/surfacecontainer.h"
 
-#include <forward_list>
+#include <QHash>
+
+#include <map>
 
 class SurfaceWrapper;
 class Workspace;
 
+// Activation order of surfaces, every activation gets a stamp larger than all
+// before it so ranking two surfaces doesn't need to walk the history
+class ActivationHistory
+{
+public:
+    void push(SurfaceWrapper *surface);
+    void remove(SurfaceWrapper *surface);
+    // 0 for surfaces that were never activated
+    quint64 stamp(SurfaceWrapper *surface) const;
+    // 0 is the latest activated surface
+    SurfaceWrapper *recent(int index) const;
+
+private:
+    QHash<SurfaceWrapper *, quint64> m_stamps;
+    std::map<quint64, SurfaceWrapper *> m_surfaces;
+};
+
 class WorkspaceModel : public SurfaceListModel
 {
     friend class Workspace;
@@ -26,7 +45,7 @@ class WorkspaceModel : public SurfaceListModel
 public:
     explicit WorkspaceModel(QObject *parent,
                             int id,
-                            std::forward_list<SurfaceWrapper *> activedSurfaceHistory);
+                            const ActivationHistory &activedSurfaceHistory);
 
     QString name() const;
     void setName(const QString &newName);
@@ -47,7 +66,7 @@ public:
     Q_INVOKABLE SurfaceWrapper *findNextActivedSurface() const;
     void pushActivedSurface(SurfaceWrapper *surface);
     void removeActivedSurface(SurfaceWrapper *surface);
-    int findActivedSurfaceHistoryIndex(SurfaceWrapper *surface) const;
+    quint64 activationStamp(SurfaceWrapper *surface) const;
 
 Q_SIGNALS:
     void nameChanged();
@@ -60,5 +79,5 @@ private:
     int m_id = -1;
     bool m_visible = false;
     bool m_opaque = true;
-    std::forward_list<SurfaceWrapper *> m_activedSurfaceHistory;
+    ActivationHistory m_activedSurfaceHistory;
 };
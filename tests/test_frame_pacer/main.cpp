@@ -0,0 +1,100 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/framepacer.h"
+
+#include <QObject>
+#include <QTest>
+
+class FramePacerTest : public QObject
+{
+    Q_OBJECT
+
+    static constexpr qint64 Refresh60 = 16'666'667;
+    static constexpr qint64 Msec = 1'000'000;
+
+private Q_SLOTS:
+
+    void noDelayWithoutHistory()
+    {
+        FramePacer pacer;
+        for (int i = 0; i < FramePacer::MinSamples - 1; ++i)
+            pacer.addRenderTime(2 * Msec);
+        QCOMPARE(pacer.renderDelay(Refresh60), 0);
+
+        pacer.addRenderTime(2 * Msec);
+        QVERIFY(pacer.renderDelay(Refresh60) > 0);
+    }
+
+    void delayLeavesRoomForSlowestFrame()
+    {
+        FramePacer pacer;
+        for (int i = 0; i < 16; ++i)
+            pacer.addRenderTime(i == 5 ? 6 * Msec : 2 * Msec);
+
+        const qint64 delay = pacer.renderDelay(Refresh60);
+        QCOMPARE(pacer.renderBudget(), 6 * Msec + 6 * Msec / 4 + FramePacer::SafetyMargin);
+        QCOMPARE(delay, Refresh60 - pacer.renderBudget());
+        QVERIFY(delay + 6 * Msec < Refresh60);
+    }
+
+    void slowFramesStartRightAway()
+    {
+        FramePacer pacer;
+        for (int i = 0; i < 16; ++i)
+            pacer.addRenderTime(14 * Msec);
+        QCOMPARE(pacer.renderDelay(Refresh60), 0);
+        QCOMPARE(pacer.renderDelay(0), 0);
+    }
+
+    void oldFramesAreForgotten()
+    {
+        FramePacer pacer;
+        for (int i = 0; i < 16; ++i)
+            pacer.addRenderTime(12 * Msec);
+        for (int i = 0; i < 16; ++i)
+            pacer.addRenderTime(2 * Msec);
+        QCOMPARE(pacer.renderBudget(), 2 * Msec + 2 * Msec / 4 + FramePacer::SafetyMargin);
+    }
+
+    void clientInterval()
+    {
+        FramePacer pacer;
+        qint64 now = 1'000 * Msec;
+        // A 24 fps video
+        const qint64 interval = 41'666'667;
+        for (int i = 0; i < 10; ++i) {
+            pacer.addClientCommit(now);
+            now += interval;
+        }
+        QVERIFY(qAbs(pacer.clientInterval(now - interval) - interval) < Msec);
+
+        // Idle clients are not followed
+        QCOMPARE(pacer.clientInterval(now + FramePacer::ClientIdleTimeout), 0);
+        pacer.addClientCommit(now + FramePacer::ClientIdleTimeout + Msec);
+        QCOMPARE(pacer.clientInterval(now + FramePacer::ClientIdleTimeout + Msec), 0);
+
+        pacer.resetClient();
+        QCOMPARE(pacer.clientInterval(now), 0);
+    }
+
+    void commitBeforeFrame()
+    {
+        FramePacer pacer;
+        QVERIFY(!pacer.takeClientCommit());
+
+        // The client commits before the frame event, that frame must not wait
+        pacer.addClientCommit(1'000 * Msec);
+        QVERIFY(pacer.takeClientCommit());
+        // The next frame has nothing new and waits for the client
+        QVERIFY(!pacer.takeClientCommit());
+
+        // Commits of a client no longer followed don't count
+        pacer.addClientCommit(1'020 * Msec);
+        pacer.resetClient();
+        QVERIFY(!pacer.takeClientCommit());
+    }
+};
+
+QTEST_MAIN(FramePacerTest)
+#include "main.moc"
@@ -0,0 +1,185 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "multitasklayout.h"
+
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTest>
+
+class MultitaskLayoutTest : public QObject
+{
+    Q_OBJECT
+
+    // The values of a 1920x1080 output with the default config
+    static MultitaskLayout::Options defaultOptions()
+    {
+        MultitaskLayout::Options options;
+        options.availWidth = 1920 - 2 * 20;
+        options.availHeight = 1080 - 240 - 60;
+        options.cellPadding = 12;
+        options.loadFactor = 0.6;
+        options.maxRowHeight = 720;
+        options.minRowHeight = 232;
+        options.rowHeightStep = 15;
+        return options;
+    }
+
+    static QList<QSizeF> randomSizes(int count, quint32 seed = 42)
+    {
+        QRandomGenerator generator(seed);
+        QList<QSizeF> sizes;
+        for (int i = 0; i < count; ++i)
+            sizes.append(QSizeF(generator.bounded(300, 1900), generator.bounded(200, 1000)));
+        return sizes;
+    }
+
+    // The former linear search, one full flow per step
+    static std::pair<qreal, QList<int>> linearLayout(const MultitaskLayout::Options &options,
+                                                     const QList<QSizeF> &sizes)
+    {
+        auto tryLayout = [&](qreal rowH, bool ignoreOverlap) -> std::optional<QList<int>> {
+            QList<int> rowStarts{ 0 };
+            qreal acc = 0;
+            for (int i = 0; i < sizes.size(); ++i) {
+                const auto &size = sizes.at(i);
+                const qreal w = std::min(options.availWidth,
+                                         size.width() / size.height()
+                                                 * std::min(rowH - 2 * options.cellPadding,
+                                                            size.height())
+                                             + 2 * options.cellPadding);
+                const qreal newAcc = acc + w;
+                if (newAcc <= options.availWidth) {
+                    acc = newAcc;
+                } else if (newAcc / options.availWidth > options.loadFactor) {
+                    acc = w;
+                    rowStarts.append(i);
+                } else {
+                    acc = newAcc;
+                }
+            }
+            if (rowStarts.size() * rowH <= options.availHeight || ignoreOverlap)
+                return rowStarts;
+            return std::nullopt;
+        };
+
+        for (qreal rowH = options.maxRowHeight; rowH > options.minRowHeight;
+             rowH -= options.rowHeightStep) {
+            if (auto rows = tryLayout(rowH, false))
+                return { rowH, *rows };
+        }
+        return { options.minRowHeight, *tryLayout(options.minRowHeight, true) };
+    }
+
+private Q_SLOTS:
+
+    void matchesLinearSearch_data()
+    {
+        QTest::addColumn<int>("count");
+        for (int count : { 1, 2, 5, 10, 30, 100, 300 })
+            QTest::addRow("%d", count) << count;
+    }
+
+    void matchesLinearSearch()
+    {
+        QFETCH(int, count);
+        const auto sizes = randomSizes(count);
+        MultitaskLayout layout;
+        layout.setOptions(defaultOptions());
+        QVERIFY(layout.layout(sizes));
+
+        const auto [rowH, rowStarts] = linearLayout(defaultOptions(), sizes);
+        QCOMPARE(layout.rowHeight(), rowH);
+        QCOMPARE(layout.rowStarts(), rowStarts);
+    }
+
+    void incrementalMatchesFull()
+    {
+        auto sizes = randomSizes(50);
+        MultitaskLayout incremental;
+        incremental.setOptions(defaultOptions());
+        incremental.layout(sizes);
+
+        QRandomGenerator generator(7);
+        for (int i = 0; i < 100; ++i) {
+            const int index = generator.bounded(sizes.size());
+            switch (generator.bounded(3)) {
+            case 0:
+                sizes.remove(index);
+                break;
+            case 1:
+                sizes.insert(index, QSizeF(generator.bounded(300, 1900), generator.bounded(200, 1000)));
+                break;
+            default:
+                sizes[index] = QSizeF(generator.bounded(300, 1900), generator.bounded(200, 1000));
+                break;
+            }
+            incremental.layout(sizes);
+
+            MultitaskLayout full;
+            full.setOptions(defaultOptions());
+            full.layout(sizes);
+            QCOMPARE(incremental.rowHeight(), full.rowHeight());
+            QCOMPARE(incremental.rowStarts(), full.rowStarts());
+            for (int j = 0; j < sizes.size(); ++j)
+                QCOMPARE(incremental.cells().at(j).width, full.cells().at(j).width);
+        }
+    }
+
+    void benchmarkLinear_data()
+    {
+        QTest::addColumn<int>("count");
+        for (int count : { 10, 50, 100, 300 })
+            QTest::addRow("%d", count) << count;
+    }
+
+    void benchmarkLinear()
+    {
+        QFETCH(int, count);
+        const auto sizes = randomSizes(count);
+        QBENCHMARK {
+            linearLayout(defaultOptions(), sizes);
+        }
+    }
+
+    void benchmarkFull_data()
+    {
+        benchmarkLinear_data();
+    }
+
+    void benchmarkFull()
+    {
+        QFETCH(int, count);
+        const auto sizes = randomSizes(count);
+        QBENCHMARK {
+            MultitaskLayout layout;
+            layout.setOptions(defaultOptions());
+            layout.layout(sizes);
+        }
+    }
+
+    void benchmarkAppend_data()
+    {
+        benchmarkLinear_data();
+    }
+
+    void benchmarkAppend()
+    {
+        QFETCH(int, count);
+        auto sizes = randomSizes(count);
+        MultitaskLayout layout;
+        layout.setOptions(defaultOptions());
+        layout.layout(sizes);
+
+        // A window opened at the end mostly keeps the row height
+        QBENCHMARK {
+            sizes.append(QSizeF(800, 600));
+            layout.layout(sizes);
+            sizes.removeLast();
+            layout.layout(sizes);
+        }
+    }
+};
+
+QTEST_MAIN(MultitaskLayoutTest)
+#include "main.moc"
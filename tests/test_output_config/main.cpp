@@ -0,0 +1,108 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/outputconfigstore.h"
+
+#include <QFile>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+
+class OutputConfigTest : public QObject
+{
+    Q_OBJECT
+
+    QTemporaryDir m_dir;
+
+    QString fileName() const { return m_dir.filePath(QStringLiteral("outputs.ini")); }
+
+    static OutputConfig laptopPanel()
+    {
+        OutputConfig config;
+        config.modeSize = { 2560, 1600 };
+        config.refresh = 165000;
+        config.scale = 1.5;
+        config.transform = 0;
+        config.position = { 0, 0 };
+        config.primary = true;
+        config.adaptiveSync = true;
+        return config;
+    }
+
+private Q_SLOTS:
+
+    void init()
+    {
+        QFile::remove(fileName());
+    }
+
+    void identityFollowsEdid()
+    {
+        const QString onHdmi = OutputConfigStore::identity("Dell", "U2720Q", "ABC123", "HDMI-A-1");
+        const QString onDp = OutputConfigStore::identity("Dell", "U2720Q", "ABC123", "DP-2");
+        QCOMPARE(onHdmi, onDp);
+        QVERIFY(onHdmi != OutputConfigStore::identity("Dell", "U2720Q", "XYZ789", "DP-2"));
+    }
+
+    void identityWithoutSerial()
+    {
+        // Twin monitors without serial stay apart by connector
+        QVERIFY(OutputConfigStore::identity("AOC", "24G2", "", "DP-1")
+                != OutputConfigStore::identity("AOC", "24G2", "", "DP-2"));
+        QVERIFY(!OutputConfigStore::identity("A/B", "C", "", "WL-1").contains('/'));
+    }
+
+    void roundTrip()
+    {
+        const QString id = OutputConfigStore::identity("BOE", "0x0BCA", "", "eDP-1");
+        QVERIFY(!OutputConfigStore(fileName()).config(id));
+
+        OutputConfigStore(fileName()).setConfig(id, laptopPanel());
+        const auto config = OutputConfigStore(fileName()).config(id);
+        QVERIFY(config);
+        QCOMPARE(*config, laptopPanel());
+    }
+
+    void setPrimary()
+    {
+        OutputConfigStore store(fileName());
+        const QString panel = OutputConfigStore::identity("BOE", "0x0BCA", "", "eDP-1");
+        const QString monitor = OutputConfigStore::identity("Dell", "U2720Q", "ABC123", "DP-2");
+        store.setConfig(panel, laptopPanel());
+        OutputConfig external;
+        external.modeSize = { 3840, 2160 };
+        external.position = { 2560, 0 };
+        store.setConfig(monitor, external);
+
+        store.setPrimary(monitor);
+        QVERIFY(store.config(monitor)->primary);
+        QVERIFY(!store.config(panel)->primary);
+        QCOMPARE(store.config(monitor)->position, QPoint(2560, 0));
+    }
+
+    void setPrimaryOfUnsavedOutput()
+    {
+        OutputConfigStore store(fileName());
+        const QString panel = OutputConfigStore::identity("BOE", "0x0BCA", "", "eDP-1");
+        const QString monitor = OutputConfigStore::identity("Dell", "U2720Q", "ABC123", "DP-2");
+        store.setConfig(panel, laptopPanel());
+
+        // Chosen as primary before its mode was ever saved
+        store.setPrimary(monitor);
+        QVERIFY(store.isPrimary(monitor));
+        QVERIFY(!store.isPrimary(panel));
+        QVERIFY(!store.config(panel)->primary);
+        QVERIFY(!store.config(monitor));
+
+        // Saving the mode later keeps the flag the caller passes
+        OutputConfig external;
+        external.modeSize = { 3840, 2160 };
+        external.primary = true;
+        store.setConfig(monitor, external);
+        QVERIFY(store.config(monitor)->primary);
+        QVERIFY(store.isPrimary(monitor));
+    }
+};
+
+QTEST_MAIN(OutputConfigTest)
+#include "main.moc"
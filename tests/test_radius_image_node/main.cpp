@@ -0,0 +1,94 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tsgradiusimagenode.h"
+
+#include <QObject>
+#include <QTest>
+
+namespace {
+class RadiusImageNode : public TSGRadiusImageNode
+{
+public:
+    explicit RadiusImageNode(ClipMode mode)
+    {
+        setClipMode(mode);
+        setRadius(12);
+        setAntialiasing(true);
+    }
+
+    using TSGRadiusImageNode::geometryNode;
+    using TSGRadiusImageNode::updateGeometry;
+};
+} // namespace
+
+Q_DECLARE_METATYPE(TSGRadiusImageNode::ClipMode)
+
+class RadiusImageNodeTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void shaderModeKeepsQuad()
+    {
+        RadiusImageNode node(TSGRadiusImageNode::ClipMode::Shader);
+        node.setRect({ 0, 0, 800, 600 });
+        node.updateGeometry();
+
+        const QSGGeometry *geometry = node.geometryNode()->geometry();
+        QCOMPARE(geometry->vertexCount(), 4);
+
+        node.setRect({ 0, 0, 1024, 768 });
+        node.updateGeometry();
+        QCOMPARE(node.geometryNode()->geometry(), geometry);
+        QCOMPARE(geometry->vertexCount(), 4);
+    }
+
+    void geometryModeFollowsCorners()
+    {
+        RadiusImageNode node(TSGRadiusImageNode::ClipMode::Geometry);
+        node.setRect({ 0, 0, 800, 600 });
+        node.updateGeometry();
+        QVERIFY(node.geometryNode()->geometry()->vertexCount() > 4);
+    }
+
+    void switchingModeKeepsRadius()
+    {
+        RadiusImageNode node(TSGRadiusImageNode::ClipMode::Geometry);
+        node.setRect({ 0, 0, 800, 600 });
+        node.updateGeometry();
+
+        node.setClipMode(TSGRadiusImageNode::ClipMode::Shader);
+        node.updateGeometry();
+        QCOMPARE(node.geometryNode()->geometry()->vertexCount(), 4);
+
+        node.setClipMode(TSGRadiusImageNode::ClipMode::Geometry);
+        node.updateGeometry();
+        QVERIFY(node.geometryNode()->geometry()->vertexCount() > 4);
+    }
+
+    void benchmarkResize_data()
+    {
+        QTest::addColumn<TSGRadiusImageNode::ClipMode>("mode");
+        QTest::newRow("shader") << TSGRadiusImageNode::ClipMode::Shader;
+        QTest::newRow("geometry") << TSGRadiusImageNode::ClipMode::Geometry;
+    }
+
+    // One frame of a resize animation
+    void benchmarkResize()
+    {
+        QFETCH(TSGRadiusImageNode::ClipMode, mode);
+        RadiusImageNode node(mode);
+
+        int step = 0;
+        QBENCHMARK {
+            step = (step + 1) % 100;
+            node.setRect({ 0, 0, 800.0 + step, 600.0 + step });
+            node.updateGeometry();
+        }
+    }
+};
+
+QTEST_MAIN(RadiusImageNodeTest)
+#include "main.moc"
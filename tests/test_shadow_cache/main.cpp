@@ -0,0 +1,69 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tshadowcache.h"
+
+#include <QObject>
+#include <QTest>
+
+class ShadowCacheTest : public QObject
+{
+    Q_OBJECT
+
+    static TShadowCache::Key windowShadow()
+    {
+        TShadowCache::Key key;
+        key.radius = 18;
+        key.blur = 40;
+        key.offsetY = 10;
+        key.color = qRgba(0, 0, 0, 102);
+        key.hollow = true;
+        return key;
+    }
+
+private Q_SLOTS:
+
+    void imageSize()
+    {
+        const auto key = windowShadow();
+        const QImage image = TShadowCache::render(key);
+        const int size = 2 * TShadowCache::cornerSize(key) + 1;
+        QCOMPARE(image.size(), QSize(size, size));
+    }
+
+    // The middle row and column are stretched, so they must not change next to it
+    void middleIsUniform()
+    {
+        const auto key = windowShadow();
+        const QImage image = TShadowCache::render(key);
+        const int middle = TShadowCache::cornerSize(key);
+
+        for (int i = 0; i < image.width(); ++i) {
+            QCOMPARE(image.pixel(i, middle - 1), image.pixel(i, middle));
+            QCOMPARE(image.pixel(i, middle + 1), image.pixel(i, middle));
+            QCOMPARE(image.pixel(middle - 1, i), image.pixel(middle, i));
+            QCOMPARE(image.pixel(middle + 1, i), image.pixel(middle, i));
+        }
+    }
+
+    void hollowCenter()
+    {
+        auto key = windowShadow();
+        const int middle = TShadowCache::cornerSize(key);
+        QCOMPARE(qAlpha(TShadowCache::render(key).pixel(middle, middle)), 0);
+
+        key.hollow = false;
+        QVERIFY(qAlpha(TShadowCache::render(key).pixel(middle, middle)) > 0);
+    }
+
+    void benchmarkRender()
+    {
+        const auto key = windowShadow();
+        QBENCHMARK {
+            TShadowCache::render(key);
+        }
+    }
+};
+
+QTEST_MAIN(ShadowCacheTest)
+#include "main.moc"
@@ -0,0 +1,174 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "tquickradiuseffect.h"
+#include "tsoftwareeffects.h"
+
+#include <QObject>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickWindow>
+#include <QTest>
+
+#include <memory>
+
+class SoftwareEffectsTest : public QObject
+{
+    Q_OBJECT
+
+    static QImage filled(const QSize &size, const QColor &color)
+    {
+        QImage image(size, QImage::Format_ARGB32_Premultiplied);
+        image.fill(color);
+        return image;
+    }
+
+private Q_SLOTS:
+
+    void initTestCase()
+    {
+        QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    }
+
+    void cornerMask()
+    {
+        const QImage mask = TSoftwareEffects::cornerMask(16, Qt::TopLeftCorner);
+        QCOMPARE(mask.size(), QSize(16, 16));
+        QCOMPARE(qAlpha(mask.pixel(0, 0)), 0);
+        QCOMPARE(qAlpha(mask.pixel(15, 15)), 255);
+
+        const QImage mirrored = TSoftwareEffects::cornerMask(16, Qt::BottomRightCorner);
+        QCOMPARE(mirrored.pixel(15, 15), mask.pixel(0, 0));
+        QCOMPARE(mirrored.pixel(0, 0), mask.pixel(15, 15));
+    }
+
+    void clipCorners()
+    {
+        const QImage source = filled({ 100, 80 }, Qt::white);
+        QImage image = source;
+        TSoftwareEffects::clipCorners(image, 10, 0, 20, 10);
+
+        // The copy shared with source is left alone
+        QCOMPARE(source.pixel(0, 0), qRgba(255, 255, 255, 255));
+        QCOMPARE(qAlpha(image.pixel(0, 0)), 0);
+        QCOMPARE(qAlpha(image.pixel(99, 0)), 255);
+        QCOMPARE(qAlpha(image.pixel(99, 79)), 0);
+        QCOMPARE(qAlpha(image.pixel(0, 79)), 0);
+        QCOMPARE(image.pixel(50, 40), source.pixel(50, 40));
+    }
+
+    void boxBlurKeepsUniformImage()
+    {
+        const QColor color(40, 120, 200, 255);
+        QImage image = filled({ 64, 48 }, color);
+        TSoftwareEffects::boxBlur(image, 5);
+        QCOMPARE(image, filled({ 64, 48 }, color));
+    }
+
+    void boxBlurSmoothsEdges()
+    {
+        QImage image = filled({ 64, 16 }, Qt::black);
+        for (int y = 0; y < image.height(); ++y) {
+            auto line = reinterpret_cast<QRgb *>(image.scanLine(y));
+            for (int x = 32; x < image.width(); ++x)
+                line[x] = qRgba(255, 255, 255, 255);
+        }
+
+        TSoftwareEffects::boxBlur(image, 4);
+        const int left = qRed(image.pixel(31, 8));
+        const int right = qRed(image.pixel(32, 8));
+        QVERIFY(left > 0 && left < 128);
+        QVERIFY(right > 128 && right < 255);
+        QCOMPARE(qRed(image.pixel(0, 8)), 0);
+        QCOMPARE(qRed(image.pixel(63, 8)), 255);
+    }
+
+    void scaled()
+    {
+        const QImage image = TSoftwareEffects::scaled(filled({ 1920, 1080 }, Qt::red), { 480, 270 });
+        QCOMPARE(image.size(), QSize(480, 270));
+        const QRgb center = image.pixel(240, 135);
+        QVERIFY(qRed(center) >= 254 && qAlpha(center) >= 254);
+        QCOMPARE(qGreen(center), 0);
+    }
+
+    void benchmarkBoxBlur_data()
+    {
+        QTest::addColumn<QSize>("size");
+        QTest::addColumn<int>("radius");
+
+        QTest::newRow("quarter 1080p backdrop") << QSize(480, 270) << 4;
+        QTest::newRow("1080p") << QSize(1920, 1080) << 8;
+    }
+
+    void benchmarkBoxBlur()
+    {
+        QFETCH(QSize, size);
+        QFETCH(int, radius);
+
+        const QImage source = filled(size, Qt::darkCyan);
+        QBENCHMARK {
+            QImage image = source;
+            TSoftwareEffects::boxBlur(image, radius);
+        }
+    }
+
+    void benchmarkClipCorners()
+    {
+        const QImage source = filled({ 1920, 1080 }, Qt::darkCyan);
+        QBENCHMARK {
+            QImage image = source;
+            TSoftwareEffects::clipCorners(image, 18, 18, 18, 18);
+        }
+    }
+
+    void benchmarkScaled()
+    {
+        const QImage source = filled({ 1920, 1080 }, Qt::darkCyan);
+        QBENCHMARK {
+            TSoftwareEffects::scaled(source, { 480, 270 });
+        }
+    }
+
+    // A whole frame of the software renderer with a rounded item whose
+    // content changes every time
+    void benchmarkRadiusEffectFrame()
+    {
+        QQuickWindow window;
+        window.resize(1280, 800);
+        window.setColor(Qt::transparent);
+
+        QQmlEngine engine;
+        QQmlComponent component(&engine);
+        component.setData("import QtQuick\n"
+                          "Rectangle {\n"
+                          "    width: 1200; height: 760\n"
+                          "    border.width: 8\n"
+                          "    layer.enabled: true\n"
+                          "}\n",
+                          QUrl());
+        std::unique_ptr<QQuickItem> content(qobject_cast<QQuickItem *>(component.create()));
+        QVERIFY2(content, qPrintable(component.errorString()));
+        content->setParentItem(window.contentItem());
+
+        TQuickRadiusEffect effect(window.contentItem());
+        effect.setSize(content->size());
+        effect.setSourceItem(content.get());
+        effect.setHideSource(true);
+        effect.setRadius(18);
+
+        const QImage frame = window.grabWindow();
+        QCOMPARE(window.rendererInterface()->graphicsApi(), QSGRendererInterface::Software);
+        QCOMPARE(qAlpha(frame.pixel(0, 0)), 0);
+
+        int hue = 0;
+        QBENCHMARK {
+            content->setProperty("color", QColor::fromHsv(hue++ % 360, 200, 200));
+            window.grabWindow();
+        }
+    }
+};
+
+QTEST_MAIN(SoftwareEffectsTest)
+#include "main.moc"
@@ -0,0 +1,200 @@
+// Copyright (C) 2024 UnionTech Software Technology Co., Ltd.
+// SPDX-License-Identifier: Apache-2.0 OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "output/freespaceplacement.h"
+
+#include <QObject>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <algorithm>
+
+class WindowPlacementTest : public QObject
+{
+    Q_OBJECT
+
+    static constexpr QRectF Area{ 0, 0, 1920, 1040 };
+
+    // Windows of random size and position, with a fixed seed to be comparable
+    static QList<QRectF> randomWindows(int count)
+    {
+        QRandomGenerator generator(42);
+        QList<QRectF> windows;
+        for (int i = 0; i < count; ++i) {
+            const QSizeF size(generator.bounded(200, 900), generator.bounded(150, 700));
+            const QPointF pos(generator.bounded(int(Area.width() - size.width())),
+                              generator.bounded(int(Area.height() - size.height())));
+            windows.append({ pos, size });
+        }
+        return windows;
+    }
+
+    static const void *key(int index)
+    {
+        return reinterpret_cast<const void *>(quintptr(index + 1));
+    }
+
+private Q_SLOTS:
+
+    void emptyAreaIsCentered()
+    {
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        const auto pos = placement.findPosition({ 800, 600 });
+        QVERIFY(pos);
+        QCOMPARE(*pos, QPointF(560, 220));
+    }
+
+    void placesBesideOccupied()
+    {
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        placement.insert(key(0), { 0, 0, 1000, 1040 });
+        const auto pos = placement.findPosition({ 800, 600 });
+        QVERIFY(pos);
+        QVERIFY(!QRectF(*pos, QSizeF(800, 600)).intersects({ 0, 0, 1000, 1040 }));
+        QVERIFY(Area.contains(QRectF(*pos, QSizeF(800, 600))));
+    }
+
+    void fullAreaHasNoPlace()
+    {
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        placement.insert(key(0), Area);
+        QVERIFY(!placement.findPosition({ 100, 100 }));
+
+        placement.remove(key(0));
+        QVERIFY(placement.findPosition({ 100, 100 }));
+    }
+
+    void freeRectsDontOverlapWindows()
+    {
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        const auto windows = randomWindows(20);
+        for (int i = 0; i < windows.size(); ++i)
+            placement.insert(key(i), windows.at(i));
+
+        const auto freeRects = placement.freeRects();
+        QVERIFY(!freeRects.isEmpty());
+        for (const auto &free : freeRects) {
+            QVERIFY(Area.contains(free));
+            for (const auto &window : windows)
+                QVERIFY(!free.intersects(window));
+
+            // Maximal: growing any side leaves the area or runs into a window
+            const QList<QRectF> grown = { free.adjusted(-1, 0, 0, 0),
+                                          free.adjusted(0, -1, 0, 0),
+                                          free.adjusted(0, 0, 1, 0),
+                                          free.adjusted(0, 0, 0, 1) };
+            for (const auto &rect : grown) {
+                const bool blocked = !Area.contains(rect)
+                    || std::any_of(windows.cbegin(), windows.cend(), [&rect](const QRectF &window) {
+                           return rect.intersects(window);
+                       });
+                QVERIFY(blocked);
+            }
+        }
+
+        // Every spot not covered by a window is in some free rect
+        for (qreal y = Area.top() + 10; y < Area.bottom(); y += 20) {
+            for (qreal x = Area.left() + 10; x < Area.right(); x += 20) {
+                const QPointF point(x, y);
+                const bool covered =
+                    std::any_of(windows.cbegin(), windows.cend(), [&point](const QRectF &window) {
+                        return window.contains(point);
+                    });
+                if (covered)
+                    continue;
+                QVERIFY(std::any_of(freeRects.cbegin(),
+                                    freeRects.cend(),
+                                    [&point](const QRectF &free) {
+                                        return free.contains(point);
+                                    }));
+            }
+        }
+    }
+
+    void placedWindowIsOccupied()
+    {
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        const QSizeF size(800, 600);
+        const auto first = placement.findPosition(size);
+        QVERIFY(first);
+        placement.insert(key(0), QRectF(*first, size));
+
+        // The next window must not land on the one just placed
+        const auto second = placement.findPosition(size);
+        QVERIFY(second);
+        QVERIFY(!QRectF(*second, size).intersects(QRectF(*first, size)));
+    }
+
+    void benchmarkInsert_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::newRow("10") << 10;
+        QTest::newRow("100") << 100;
+        QTest::newRow("500") << 500;
+    }
+
+    void benchmarkInsert()
+    {
+        QFETCH(int, count);
+        const auto windows = randomWindows(count);
+
+        QBENCHMARK {
+            FreeSpacePlacement placement;
+            placement.setArea(Area);
+            placement.freeRects();
+            for (int i = 0; i < windows.size(); ++i)
+                placement.insert(key(i), windows.at(i));
+        }
+    }
+
+    void benchmarkFindPosition_data()
+    {
+        benchmarkInsert_data();
+    }
+
+    void benchmarkFindPosition()
+    {
+        QFETCH(int, count);
+        const auto windows = randomWindows(count);
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        for (int i = 0; i < windows.size(); ++i)
+            placement.insert(key(i), windows.at(i));
+        placement.freeRects();
+
+        QBENCHMARK {
+            placement.findPosition({ 200, 150 });
+        }
+    }
+
+    void benchmarkMoveWindow_data()
+    {
+        benchmarkInsert_data();
+    }
+
+    void benchmarkMoveWindow()
+    {
+        QFETCH(int, count);
+        const auto windows = randomWindows(count);
+        FreeSpacePlacement placement;
+        placement.setArea(Area);
+        for (int i = 0; i < windows.size(); ++i)
+            placement.insert(key(i), windows.at(i));
+
+        // Moving a window rebuilds on the next query
+        qreal offset = 0;
+        QBENCHMARK {
+            offset = offset > 0 ? 0 : 10;
+            placement.insert(key(0), windows.first().translated(offset, 0));
+            placement.findPosition({ 200, 150 });
+        }
+    }
+};
+
+QTEST_MAIN(WindowPlacementTest)
+#include "main.moc"